@@ -77,7 +77,7 @@ void init_fab_map( karte_t *welt )
 	for( int i=0;  i<fab_map_w*welt->get_size().y;  i++ ) {
 		fab_map[i] = 0;
 	}
-	FOR(slist_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
+	FOR(vector_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
 		add_factory_to_fab_map(welt, f);
 	}
 	if(  welt->get_settings().get_max_factory_spacing_percent() > 0  ) {
@@ -770,7 +770,7 @@ int factory_builder_t::build_chain_link(const fabrik_t* our_fab, const factory_d
 	DBG_MESSAGE("factory_builder_t::build_chain_link","supplier_count %i, lcount %i (need %i of %s)",info->get_supplier_count(),lcount,consumption,ware->get_name());
 
 	// search if there already is one or two (cross-connect everything if possible)
-	FOR(slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
+	FOR(vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
 
 		// Try to find matching factories for this consumption, but don't find more than two times number of factories requested.
 		if (  (lcount != 0  ||  consumption <= 0)  &&  lcount < lfound + 1  )
@@ -962,7 +962,7 @@ int factory_builder_t::increase_industry_density( bool tell_me )
 	// find last consumer
 	minivec_tpl<const goods_desc_t *>ware_needed;
 	if(!welt->get_fab_list().empty()) {
-		FOR(slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
+		FOR(vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
 			if (fab->get_desc()->is_consumer_only()) {
 				last_built_consumer = fab;
 				break;
@@ -1050,7 +1050,7 @@ int factory_builder_t::increase_industry_density( bool tell_me )
 	uint32 electric_supply = 0;
 	uint32 electric_demand = 1;
 
-	FOR(slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
+	FOR(vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
 		if(  fab->get_desc()->is_electricity_producer()  ) {
 			electric_supply += fab->get_scaled_electric_demand() / PRODUCTION_DELTA_T;
 		}
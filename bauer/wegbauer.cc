@@ -1270,19 +1270,12 @@ sint32 way_builder_t::intern_calc_route(const vector_tpl<koord3d> &start, const
 	koord3d mini, maxi;
 	get_mini_maxi( ziel, mini, maxi );
 
-	// memory in static list ...
-	if(route_t::nodes==NULL) {
-		route_t::MAX_STEP = welt->get_settings().get_max_route_steps(); // may need very much memory => configurable
-		route_t::nodes = new route_t::ANode[route_t::MAX_STEP+4+1];
-	}
-
-	static binary_heap_tpl <route_t::ANode *> queue;
-
-	// initialize marker field
-	marker_t& marker = marker_t::instance(welt->get_size().x, welt->get_size().y);
-
-	// clear the queue (should be empty anyhow)
-	queue.clear();
+	// memory for the search, its own one also when called during INT_CHECK
+	route_t::search_context_holder_t ctx;
+	ctx->reset(welt);
+	binary_heap_tpl <route_t::ANode *> &queue = ctx->queue;
+	marker_t &marker = ctx->marker;
+	const uint32 max_step = welt->get_settings().get_max_route_steps(); // may need very much memory => configurable
 
 	// some thing for the search
 	grund_t *to;
@@ -1300,7 +1293,7 @@ sint32 way_builder_t::intern_calc_route(const vector_tpl<koord3d> &start, const
 			// DBG_MESSAGE("way_builder_t::intern_calc_route()","cannot start on (%i,%i,%i)",start.x,start.y,start.z);
 			continue;
 		}
-		tmp = &(route_t::nodes[step]);
+		tmp = ctx->get_node(step);
 		step ++;
 
 		tmp->parent = NULL;
@@ -1320,9 +1313,6 @@ sint32 way_builder_t::intern_calc_route(const vector_tpl<koord3d> &start, const
 
 	INT_CHECK("wegbauer 347");
 
-	// get exclusively the tile list
-	route_t::GET_NODE();
-
 	// to speed up search, but may not find all shortest ways
 	uint32 min_dist = 99999999;
 
@@ -1488,7 +1478,7 @@ DBG_DEBUG("insert to close","(%i,%i,%i)  f=%i",gr->get_pos().x,gr->get_pos().y,g
 			}
 
 			// not in there or taken out => add new
-			route_t::ANode *k=&(route_t::nodes[step]);
+			route_t::ANode *k = ctx->get_node(step);
 			step++;
 
 			k->parent = tmp;
@@ -1506,19 +1496,17 @@ DBG_DEBUG("insert to open","(%i,%i,%i)  f=%i",to->get_pos().x,to->get_pos().y,to
 #endif
 		}
 
-	} while (!queue.empty() && step < route_t::MAX_STEP);
+	} while (!queue.empty() && step < max_step);
 
 #ifdef DEBUG_ROUTES
-DBG_DEBUG("way_builder_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u",step,route_t::MAX_STEP,queue.get_count(),tmp->g);
+DBG_DEBUG("way_builder_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u",step,max_step,queue.get_count(),tmp->g);
 #endif
 	INT_CHECK("wegbauer 194");
 
-	route_t::RELEASE_NODE();
-
 	// target reached?
-	if(  !ziel.is_contained(gr->get_pos())  ||  step>=route_t::MAX_STEP  ||  tmp->parent==NULL  ||  tmp->g > maximum  ) {
-		if (step>=route_t::MAX_STEP) {
-			dbg->warning("way_builder_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,route_t::MAX_STEP);
+	if(  !ziel.is_contained(gr->get_pos())  ||  step>=max_step  ||  tmp->parent==NULL  ||  tmp->g > maximum  ) {
+		if (step>=max_step) {
+			dbg->warning("way_builder_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,max_step);
 		}
 		return -1;
 	}
@@ -1735,20 +1723,14 @@ sint32 way_builder_t::intern_calc_route_elevated(const koord3d start, const koor
 	}
 
 
-	// memory in static list ...
-	if(route_t::nodes==NULL) {
-		route_t::MAX_STEP = welt->get_settings().get_max_route_steps(); // may need very much memory => configurable
-		route_t::nodes = new route_t::ANode[route_t::MAX_STEP+4+1];
-	}
-
-	static binary_heap_tpl <route_t::ANode *> queue;
-
-	// initialize marker field
-	marker_t& markerbelow = marker_t::instance(welt->get_size().x, welt->get_size().y);
-	marker_t& markerabove = marker_t::instance_second(welt->get_size().x, welt->get_size().y);
-
-	// clear the queue (should be empty anyhow)
-	queue.clear();
+	// memory for the search, its own one also when called during INT_CHECK
+	route_t::search_context_holder_t ctx;
+	ctx->reset(welt);
+	ctx->upper_marker.init(welt->get_size().x, welt->get_size().y);
+	binary_heap_tpl <route_t::ANode *> &queue = ctx->queue;
+	marker_t &markerbelow = ctx->marker;
+	marker_t &markerabove = ctx->upper_marker;
+	const uint32 max_step = welt->get_settings().get_max_route_steps(); // may need very much memory => configurable
 
 	// some thing for the search
 	grund_t *to;
@@ -1762,7 +1744,7 @@ sint32 way_builder_t::intern_calc_route_elevated(const koord3d start, const koor
 	sint32 dummy;
 	if( gr && is_allowed_step(gr,gr,&dummy) ) {
 		// DBG_MESSAGE("way_builder_t::intern_calc_route()","cannot start on (%i,%i,%i)",start.x,start.y,start.z);
-		tmp = &(route_t::nodes[step]);
+		tmp = ctx->get_node(step);
 		step ++;
 		tmp->parent = NULL;
 		tmp->gr = gr;
@@ -1778,7 +1760,7 @@ sint32 way_builder_t::intern_calc_route_elevated(const koord3d start, const koor
 	gu = welt->lookup(start + koordup);
 	if( gu && is_allowed_step(gu,gu,&dummy, true) ) {
 		// DBG_MESSAGE("way_builder_t::intern_calc_route()","cannot start on (%i,%i,%i)",start.x,start.y,start.z);
-		tmp = &(route_t::nodes[step]);
+		tmp = ctx->get_node(step);
 		step ++;
 		tmp->parent = NULL;
 		tmp->gr = gu;
@@ -1799,9 +1781,6 @@ sint32 way_builder_t::intern_calc_route_elevated(const koord3d start, const koor
 
 	INT_CHECK("wegbauer 347");
 
-	// get exclusively the tile list
-	route_t::GET_NODE();
-
 	// to speed up search, but may not find all shortest ways
 	uint32 min_dist = 99999999;
 
@@ -1995,7 +1974,7 @@ DBG_DEBUG("insert to close","(%i,%i,%i)  f=%i",gr->get_pos().x,gr->get_pos().y,g
 			}
 
 			// not in there or taken out => add new
-			route_t::ANode *k=&(route_t::nodes[step]);
+			route_t::ANode *k = ctx->get_node(step);
 			step++;
 
 			k->parent = tmp;
@@ -2013,19 +1992,17 @@ DBG_DEBUG("insert to open","(%i,%i,%i)  f=%i",to->get_pos().x,to->get_pos().y,to
 #endif
 		}
 
-	} while (!queue.empty() && step < route_t::MAX_STEP);
+	} while (!queue.empty() && step < max_step);
 
 #ifdef DEBUG_ROUTES
-DBG_DEBUG("way_builder_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u",step,route_t::MAX_STEP,queue.get_count(),tmp->g);
+DBG_DEBUG("way_builder_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u",step,max_step,queue.get_count(),tmp->g);
 #endif
 	INT_CHECK("wegbauer 194");
 
-	route_t::RELEASE_NODE();
-
 	// target reached?
-	if(  !(ziel == gr_pos)  ||  step>=route_t::MAX_STEP  ||  tmp->parent==NULL  ||  tmp->g > maximum  ) {
-		if (step>=route_t::MAX_STEP) {
-			dbg->warning("way_builder_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,route_t::MAX_STEP);
+	if(  !(ziel == gr_pos)  ||  step>=max_step  ||  tmp->parent==NULL  ||  tmp->g > maximum  ) {
+		if (step>=max_step) {
+			dbg->warning("way_builder_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,max_step);
 		}
 		return -1;
 	}
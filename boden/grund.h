@@ -422,7 +422,7 @@ public:
 
 	// slope are now maintained locally
 	slope_t::type get_grund_hang() const { return slope; }
-	void set_grund_hang(slope_t::type sl) { slope = sl; }
+	void set_grund_hang(slope_t::type sl) { slope = sl; weg_t::increment_generation(); }
 
 	/**
 	 * some ground tiles may be part of halts.
@@ -603,6 +603,7 @@ public:
 	obj_t * obj_bei(uint8 n) const { return objlist.bei(n); }
 	uint8  obj_count() const { return objlist.get_top()-offsets[flags/has_way1]; }
 	uint8 get_top() const {return objlist.get_top();}
+	uint32 get_objlist_changes() const { return objlist.get_changes(); }
 
 	// moves all object from the old to the new grund_t
 	void take_obj_from( grund_t *gr);
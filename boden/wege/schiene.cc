@@ -21,6 +21,7 @@
 
 const way_desc_t *schiene_t::default_schiene=NULL;
 bool schiene_t::show_reservations = false;
+uint32 schiene_t::deleted_count = 0;
 
 
 schiene_t::schiene_t() : weg_t()
@@ -30,6 +30,11 @@ public:
 
 	static bool show_reservations;
 
+	/**
+	* Incremented whenever a rail is deleted, pointers to rails are valid while unchanged.
+	*/
+	static uint32 deleted_count;
+
 	/**
 	* File loading constructor.
 	*/
@@ -37,6 +42,8 @@ public:
 
 	schiene_t();
 
+	virtual ~schiene_t() { deleted_count++; }
+
 	waytype_t get_waytype() const OVERRIDE {return track_wt;}
 
 	/**
@@ -7,6 +7,7 @@
 
 #include "strasse.h"
 #include "../../simworld.h"
+#include "../grund.h"
 #include "../../dataobj/loadsave.h"
 #include "../../descriptor/way_desc.h"
 #include "../../bauer/wegbauer.h"
@@ -34,6 +35,7 @@ void strasse_t::set_gehweg(bool janein)
 
 strasse_t::strasse_t(loadsave_t *file) : weg_t()
 {
+	vehicle_cache = NULL;
 	rdwr(file);
 	for(uint8 i=0; i<4; i++) {
 		reserved_by[i] = NULL;
@@ -41,8 +43,15 @@ strasse_t::strasse_t(loadsave_t *file) : weg_t()
 }
 
 
+strasse_t::~strasse_t()
+{
+	delete vehicle_cache;
+}
+
+
 strasse_t::strasse_t() : weg_t()
 {
+	vehicle_cache = NULL;
 	set_gehweg(false);
 	set_desc(default_strasse);
 	ribi_mask_oneway =ribi_t::none;
@@ -260,6 +269,29 @@ bool strasse_t::is_reserved_by_others(vehicle_base_t* r, bool is_overtaking, koo
 	return false;
 }
 
+const vector_tpl<vehicle_base_t *> &strasse_t::get_vehicles(const grund_t *gr) const
+{
+	if(  vehicle_cache == NULL  ) {
+		vehicle_cache = new vehicle_cache_t();
+		vehicle_cache->gr = NULL;
+	}
+	else if(  vehicle_cache->gr == gr  &&  vehicle_cache->objlist_changes == gr->get_objlist_changes()  ) {
+		return vehicle_cache->vehicles;
+	}
+	vehicle_cache->gr = gr;
+	vehicle_cache->objlist_changes = gr->get_objlist_changes();
+	vehicle_cache->vehicles.clear();
+	// position 0 is always a way
+	for(  uint8 pos=1;  pos<gr->get_top();  pos++  ) {
+		if(  vehicle_base_t* const v = obj_cast<vehicle_base_t>(gr->obj_bei(pos))  ) {
+			if(  v->get_typ() != obj_t::pedestrian  &&  (obj_cast<road_vehicle_t>(v)  ||  v->get_waytype() == road_wt)  ) {
+				vehicle_cache->vehicles.append( v );
+			}
+		}
+	}
+	return vehicle_cache->vehicles;
+}
+
 bool strasse_t::reserve(vehicle_base_t* r, bool is_overtaking, koord3d pos_prev, koord3d pos_next) {
 	ribi_t::ribi dir_in = ribi_type(get_pos(), pos_prev);
 	ribi_t::ribi dir_out = ribi_type(get_pos(), pos_next);
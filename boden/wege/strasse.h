@@ -8,11 +8,13 @@
 
 
 #include "weg.h"
+#include "../../tpl/vector_tpl.h"
 
 // number of different traffic directions
 #define MAX_WAY_STAT_DIRECTIONS 2
 
 class vehicle_base_t;
+class grund_t;
 
 /**
  * Cars are able to drive on roads.
@@ -83,11 +85,23 @@ private:
 	*/
 	vehicle_base_t* reserved_by[4];
 
+	/**
+	 * Road vehicles and citycars on this tile in the order of the objlist,
+	 * rebuilt when the objlist of the tile changed. Allocated on first use.
+	 */
+	struct vehicle_cache_t {
+		const grund_t *gr;
+		uint32 objlist_changes;
+		vector_tpl<vehicle_base_t *> vehicles;
+	};
+	mutable vehicle_cache_t *vehicle_cache;
+
 public:
 	static const way_desc_t *default_strasse;
 
 	strasse_t(loadsave_t *file);
 	strasse_t();
+	virtual ~strasse_t();
 
 	inline waytype_t get_waytype() const OVERRIDE {return road_wt;}
 
@@ -133,6 +147,12 @@ public:
 	bool unreserve(vehicle_base_t* r);
 	void unreserve_all();
 	bool is_reserved_by_others(vehicle_base_t* r, bool is_overtaking, koord3d pos_prev, koord3d pos_next);
+
+	/**
+	 * @returns the road vehicles and citycars (no pedestrians) on @p gr, which must be the ground of this road.
+	 * Only valid until the objects on the tile change.
+	 */
+	const vector_tpl<vehicle_base_t *> &get_vehicles(const grund_t *gr) const;
 	
 	uint8 get_street_flag() const { return street_flags; }
 	void set_street_flag(uint8 s) { street_flags = s; }
@@ -46,6 +46,19 @@ static recursive_mutex_maker_t weg_cim_maker(weg_calc_image_mutex);
  */
 slist_tpl <weg_t *> alle_wege;
 
+uint32 weg_t::generations[GENERATION_COUNT];
+bool weg_t::generation_frozen = false;
+
+
+void weg_t::increment_generation()
+{
+	if(  !generation_frozen  ) {
+		for(  int i = 0;  i < GENERATION_COUNT;  i++  ) {
+			generations[i]++;
+		}
+	}
+}
+
 /**
  * Get list of all ways
  */
@@ -114,6 +127,7 @@ const char *weg_t::waytype_to_string(waytype_t wt)
 void weg_t::set_desc(const way_desc_t *b)
 {
 	desc = b;
+	changed();
 
 	if(  hat_gehweg() &&  desc->get_wtyp() == road_wt  &&  desc->get_topspeed() > 50  ) {
 		max_speed = 50;
@@ -157,6 +171,7 @@ void weg_t::init()
 weg_t::~weg_t()
 {
 	alle_wege.remove(this);
+	changed();
 	player_t *player=get_owner();
 	if(player) {
 		player_t::add_maintenance( player,  -desc->get_maintenance(), desc->get_finance_waytype() );
@@ -295,6 +310,7 @@ void weg_t::info(cbuffer_t & buf) const
 void weg_t::rotate90()
 {
 	obj_t::rotate90();
+	// counted by karte_t::rotate90() after rotating all tiles
 	ribi = ribi_t::rotate90( ribi );
 	ribi_maske = ribi_t::rotate90( ribi_maske );
 }
@@ -306,6 +322,7 @@ void weg_t::rotate90()
  */
 void weg_t::count_sign()
 {
+	changed();
 	// Either only sign or signal please ...
 	flags &= ~(HAS_SIGN|HAS_SIGNAL|HAS_CROSSING);
 	const grund_t *gr=welt->lookup(get_pos());
@@ -52,6 +52,22 @@ public:
 	*/
 	static const slist_tpl <weg_t *> & get_alle_wege();
 
+	/**
+	 * Changes whenever a way of this waytype, its directions, speed limit, electrification or signs change,
+	 * so results of route searches can be reused until then (see route_t).
+	 */
+	static uint32 get_generation(waytype_t wt) { return generations[get_generation_index(wt)]; }
+
+	/// for changes of all waytypes, like slopes or depots
+	static void increment_generation();
+	static void increment_generation(waytype_t wt) { if(  !generation_frozen  ) { generations[get_generation_index(wt)]++; } }
+
+	/**
+	 * While frozen (during parallel loops over the map) changes are not counted,
+	 * the caller must call increment_generation() afterwards.
+	 */
+	static void freeze_generation(bool frozen) { generation_frozen = frozen; }
+
 	enum {
 		HAS_SIDEWALK   = 1 << 0,
 		IS_ELECTRIFIED = 1 << 1,
@@ -64,6 +80,23 @@ public:
 	};
 
 private:
+	enum { GENERATION_COUNT = 11 };
+	static uint32 generations[GENERATION_COUNT];
+	static bool generation_frozen;
+
+	/// trams run on track ways, all other waytypes have their own counter
+	static uint8 get_generation_index(waytype_t wt)
+	{
+		switch(  wt  ) {
+			case tram_wt: return track_wt;
+			case air_wt:  return narrowgauge_wt+1;
+			default:      return (unsigned)wt <= narrowgauge_wt ? (uint8)wt : narrowgauge_wt+2;
+		}
+	}
+
+	/// counts a change of this way
+	void changed() { if(  desc  ) { increment_generation( desc->get_wtyp() ); } else { increment_generation(); } }
+
 	/**
 	* array for statistical values
 	* MAX_WAY_STAT_MONTHS: [0] = actual value; [1] = last month value
@@ -154,7 +187,7 @@ public:
 	 */
 	bool check_season(const bool calc_only_season_change) OVERRIDE;
 
-	void set_max_speed(sint32 s) { max_speed = s; }
+	void set_max_speed(sint32 s) { max_speed = s; changed(); }
 	sint32 get_max_speed() const { return max_speed; }
 
 	/// @note Replaces max speed of the way by the max speed property of the descriptor.
@@ -195,7 +228,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi;}
+	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi; changed(); }
 
 	/**
 	* Remove direction bits (ribi) for a way.
@@ -203,7 +236,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi;}
+	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi; changed(); }
 
 	/**
 	* Set direction bits (ribi) for the way.
@@ -211,7 +244,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi;}
+	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi; changed(); }
 
 	/**
 	* Get the unmasked direction bits (ribi) for the way (without signals or other ribi changer).
@@ -229,7 +262,7 @@ public:
 	* For signals it is necessary to mask out certain ribi to prevent vehicles
 	* from driving the wrong way (e.g. oneway roads)
 	*/
-	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; }
+	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; changed(); }
 	ribi_t::ribi get_ribi_maske() const { return (ribi_t::ribi)ribi_maske; }
 
 	/**
@@ -262,7 +295,7 @@ public:
 	void set_gehweg(const bool yesno) { flags = (yesno ? flags | HAS_SIDEWALK : flags & ~HAS_SIDEWALK); }
 	inline bool hat_gehweg() const { return flags & HAS_SIDEWALK; }
 
-	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED;}
+	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED; changed(); }
 	inline bool is_electrified() const {return flags&IS_ELECTRIFIED; }
 
 	inline bool has_sign() const {return flags&HAS_SIGN; }
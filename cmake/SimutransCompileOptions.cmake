@@ -44,6 +44,7 @@ option(SIMUTRANS_ENABLE_PROFILING "Enable profiling code" OFF)
 option(SIMUTRANS_USE_SYSLOG "Enable logging to syslog" OFF)
 option(SIMUTRANS_USE_IP4_ONLY "Use only IPv4" OFF)
 option(SIMUTRANS_STEAM_BUILT "Compile a Steam build" OFF)
+option(SIMUTRANS_QUICKSTONE_32BIT "Allow more than 65535 stops, convoys and lines" OFF)
 option(DEBUG_FLUSH_BUFFER "Highlite areas changes since last redraw" OFF)
 option(ENABLE_WATERWAY_SIGNS "Allow private signs on watersways" OFF)
 option(AUTOJOIN_PUBLIC "Join when making things public" OFF)
@@ -26,6 +26,7 @@ target_sources(simutrans PRIVATE
 		dataobj/crossing_logic.cc
 		dataobj/environment.cc
 		dataobj/freelist.cc
+		dataobj/freight_store.cc
 		dataobj/gameinfo.cc
 		dataobj/height_map_loader.cc
 		dataobj/koord.cc
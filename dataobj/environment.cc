@@ -138,6 +138,12 @@ uint32 env_t::fps;
 uint32 env_t::ff_fps;
 sint16 env_t::max_acceleration;
 uint8 env_t::num_threads;
+bool env_t::parallel_convoi_step;
+bool env_t::parallel_sync_step;
+bool env_t::parallel_reconnect;
+bool env_t::parallel_passenger_routing;
+bool env_t::parallel_factory_step;
+uint32 env_t::route_cache_size;
 bool env_t::show_tooltips;
 uint32 env_t::tooltip_color_rgb;
 PIXVAL env_t::tooltip_color;
@@ -285,6 +291,12 @@ void env_t::init()
 #else
 	num_threads = 1;
 #endif
+	parallel_convoi_step = false;
+	parallel_sync_step = false;
+	parallel_reconnect = false;
+	parallel_passenger_routing = false;
+	parallel_factory_step = false;
+	route_cache_size = 256;
 
 	sound_distance_scaling = 10;
 
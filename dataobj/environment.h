@@ -406,6 +406,24 @@ public:
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/// search the routes of the convois in parallel before stepping them (if MULTI_THREAD defined)
+	static bool parallel_convoi_step;
+
+	/// move vehicles, which stay on their tiles, on all threads (if MULTI_THREAD defined)
+	static bool parallel_sync_step;
+
+	/// rebuild the connections of the halts on all threads (if MULTI_THREAD defined)
+	static bool parallel_reconnect;
+
+	/// search the routes of new passengers and mail on all threads (if MULTI_THREAD defined)
+	static bool parallel_passenger_routing;
+
+	/// compute the production of the factories on all threads (if MULTI_THREAD defined)
+	static bool parallel_factory_step;
+
+	/// number of route searches kept for reuse by trains (0 = off)
+	static uint32 route_cache_size;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
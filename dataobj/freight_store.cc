@@ -0,0 +1,341 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "freight_store.h"
+
+#include "../simmem.h"
+
+
+freight_store_t::freight_store_t() :
+	removed(0),
+	destination_index(NULL),
+	zielpos_index(NULL),
+	zielpos_last(NULL),
+	index_size(0),
+	index_entries(0),
+	zielpos_entries(0)
+{
+}
+
+
+freight_store_t::~freight_store_t()
+{
+	clear();
+}
+
+
+void freight_store_t::clear()
+{
+	packets.clear();
+	removed = 0;
+	FOR(vector_tpl<via_t *>, via, vias) {
+		delete via;
+	}
+	vias.clear();
+	free( destination_index );
+	free( zielpos_index );
+	free( zielpos_last );
+	destination_index = NULL;
+	zielpos_index = NULL;
+	zielpos_last = NULL;
+	zielpos_next.clear();
+	index_size = 0;
+	index_entries = 0;
+	zielpos_entries = 0;
+}
+
+
+uint32 freight_store_t::destination_hash(const ware_t &ware)
+{
+	uint32 h = ware.get_index() * 0x9E3779B1u;
+	h ^= (ware.get_ziel().get_id() + 1) * 0x85EBCA6Bu;
+	if(  ware.to_factory  ) {
+		h ^= ((uint32)(uint16)ware.get_zielpos().x << 16 | (uint16)ware.get_zielpos().y) * 0xC2B2AE35u;
+		h += 1;
+	}
+	return h ^ (h >> 15);
+}
+
+
+uint32 freight_store_t::zielpos_hash(uint8 index, koord zielpos)
+{
+	uint32 h = index * 0x9E3779B1u;
+	h ^= ((uint32)(uint16)zielpos.x << 16 | (uint16)zielpos.y) * 0xC2B2AE35u;
+	return h ^ (h >> 15);
+}
+
+
+freight_store_t::via_t *freight_store_t::get_or_add_via(halthandle_t halt)
+{
+	// binary search for the halt id
+	uint32 lo = 0, hi = vias.get_count();
+	while(  lo < hi  ) {
+		const uint32 mid = (lo + hi) / 2;
+		if(  vias[mid]->halt.get_id() < halt.get_id()  ) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	if(  lo < vias.get_count()  &&  vias[lo]->halt == halt  ) {
+		return vias[lo];
+	}
+	via_t *via = new via_t();
+	via->halt = halt;
+	vias.insert_at( lo, via );
+	return via;
+}
+
+
+const vector_tpl<uint32> *freight_store_t::get_via(halthandle_t halt) const
+{
+	uint32 lo = 0, hi = vias.get_count();
+	while(  lo < hi  ) {
+		const uint32 mid = (lo + hi) / 2;
+		if(  vias[mid]->halt.get_id() < halt.get_id()  ) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	if(  lo < vias.get_count()  &&  vias[lo]->halt == halt  ) {
+		return &vias[lo]->positions;
+	}
+	return NULL;
+}
+
+
+void freight_store_t::prune_via(halthandle_t halt)
+{
+	vector_tpl<uint32> *positions = const_cast<vector_tpl<uint32> *>( get_via( halt ) );
+	if(  positions == NULL  ) {
+		return;
+	}
+	uint32 kept = 0;
+	for(  uint32 i = 0;  i < positions->get_count();  i++  ) {
+		const ware_t &ware = packets[ (*positions)[i] ];
+		if(  ware.menge > 0  &&  ware.get_zwischenziel() == halt  ) {
+			(*positions)[kept++] = (*positions)[i];
+		}
+	}
+	while(  positions->get_count() > kept  ) {
+		positions->pop_back();
+	}
+}
+
+
+void freight_store_t::add_to_via(uint32 pos)
+{
+	vector_tpl<uint32> &positions = get_or_add_via( packets[pos].get_zwischenziel() )->positions;
+	if(  positions.empty()  ||  positions.back() < pos  ) {
+		// usual case: newest packet
+		positions.append( pos );
+		return;
+	}
+	uint32 lo = 0, hi = positions.get_count();
+	while(  lo < hi  ) {
+		const uint32 mid = (lo + hi) / 2;
+		if(  positions[mid] < pos  ) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	if(  positions[lo] != pos  ) {
+		positions.insert_at( lo, pos );
+	}
+}
+
+
+void freight_store_t::add_to_indices(uint32 pos, bool only_destination)
+{
+	if(  (index_entries + 1) * 2 > index_size  ||  (zielpos_entries + 1) * 2 > index_size  ) {
+		// also adds this packet
+		rebuild_indices();
+		return;
+	}
+	const uint32 mask = index_size - 1;
+	const ware_t &ware = packets[pos];
+
+	for(  uint32 i = destination_hash( ware ) & mask;  ;  i = (i + 1) & mask  ) {
+		if(  destination_index[i] == 0  ) {
+			destination_index[i] = pos + 1;
+			index_entries++;
+			break;
+		}
+		if(  destination_index[i] != REMOVED_ENTRY  &&  packets[destination_index[i] - 1].same_destination( ware )  ) {
+			// keep the newer packet, or the non-empty one
+			if(  destination_index[i] - 1 < pos  ||  packets[destination_index[i] - 1].menge == 0  ) {
+				destination_index[i] = pos + 1;
+			}
+			break;
+		}
+	}
+
+	if(  only_destination  ) {
+		return;
+	}
+	for(  uint32 i = zielpos_hash( ware.get_index(), ware.get_zielpos() ) & mask;  ;  i = (i + 1) & mask  ) {
+		if(  zielpos_index[i] == 0  ) {
+			zielpos_index[i] = pos + 1;
+			zielpos_last[i] = pos;
+			zielpos_entries++;
+			break;
+		}
+		if(  zielpos_index[i] == REMOVED_ENTRY  ) {
+			continue;
+		}
+		const ware_t &other = packets[zielpos_index[i] - 1];
+		if(  other.get_index() == ware.get_index()  &&  other.get_zielpos() == ware.get_zielpos()  ) {
+			// packets are added in ascending order, so this is the newest
+			zielpos_next[ zielpos_last[i] ] = pos;
+			zielpos_last[i] = pos;
+			break;
+		}
+	}
+}
+
+
+void freight_store_t::rebuild_indices()
+{
+	uint32 size = 16;
+	while(  size < packets.get_count() * 4  ) {
+		size *= 2;
+	}
+	if(  size != index_size  ) {
+		free( destination_index );
+		free( zielpos_index );
+		free( zielpos_last );
+		destination_index = MALLOCN( uint32, size );
+		zielpos_index = MALLOCN( uint32, size );
+		zielpos_last = MALLOCN( uint32, size );
+		index_size = size;
+	}
+	MEMZERON( destination_index, index_size );
+	MEMZERON( zielpos_index, index_size );
+	index_entries = 0;
+	zielpos_entries = 0;
+	zielpos_next.clear();
+	zielpos_next.resize( packets.get_count() );
+	for(  uint32 pos = 0;  pos < packets.get_count();  pos++  ) {
+		zielpos_next.append( NO_PACKET );
+	}
+	for(  uint32 pos = 0;  pos < packets.get_count();  pos++  ) {
+		if(  packets[pos].menge > 0  ) {
+			add_to_indices( pos, false );
+		}
+	}
+}
+
+
+void freight_store_t::append(const ware_t &ware)
+{
+	packets.append( ware );
+	zielpos_next.append( NO_PACKET );
+	const uint32 pos = packets.get_count() - 1;
+	add_to_via( pos );
+	add_to_indices( pos, false );
+}
+
+
+void freight_store_t::remove(uint32 pos)
+{
+	if(  index_size > 0  ) {
+		// new packets must not be merged into this one
+		const uint32 mask = index_size - 1;
+		const ware_t &ware = packets[pos];
+		for(  uint32 i = destination_hash( ware ) & mask;  destination_index[i] != 0;  i = (i + 1) & mask  ) {
+			if(  destination_index[i] == pos + 1  ) {
+				destination_index[i] = REMOVED_ENTRY;
+				break;
+			}
+		}
+		for(  uint32 i = zielpos_hash( ware.get_index(), ware.get_zielpos() ) & mask;  zielpos_index[i] != 0;  i = (i + 1) & mask  ) {
+			if(  zielpos_index[i] == pos + 1  ) {
+				// point to the next newer packet still waiting
+				uint32 next = zielpos_next[pos];
+				while(  next != NO_PACKET  &&  packets[next].menge == 0  ) {
+					next = zielpos_next[next];
+				}
+				zielpos_index[i] = next != NO_PACKET ? next + 1 : (uint32)REMOVED_ENTRY;
+				break;
+			}
+		}
+	}
+	packets[pos].menge = 0;
+	removed++;
+}
+
+
+void freight_store_t::update(uint32 pos)
+{
+	add_to_via( pos );
+	add_to_indices( pos, true );
+}
+
+
+uint32 freight_store_t::find_same_destination(const ware_t &ware) const
+{
+	if(  index_size == 0  ) {
+		return NO_PACKET;
+	}
+	const uint32 mask = index_size - 1;
+	for(  uint32 i = destination_hash( ware ) & mask;  destination_index[i] != 0;  i = (i + 1) & mask  ) {
+		const uint32 pos = destination_index[i] - 1;
+		// entries left by update() can point to emptied packets
+		if(  destination_index[i] != REMOVED_ENTRY  &&  packets[pos].menge > 0  &&  packets[pos].same_destination( ware )  ) {
+			return pos;
+		}
+	}
+	return NO_PACKET;
+}
+
+
+uint32 freight_store_t::find_zielpos(uint8 index, koord zielpos) const
+{
+	if(  index_size == 0  ) {
+		return NO_PACKET;
+	}
+	const uint32 mask = index_size - 1;
+	for(  uint32 i = zielpos_hash( index, zielpos ) & mask;  zielpos_index[i] != 0;  i = (i + 1) & mask  ) {
+		const uint32 pos = zielpos_index[i] - 1;
+		if(  zielpos_index[i] != REMOVED_ENTRY  &&  packets[pos].get_index() == index  &&  packets[pos].get_zielpos() == zielpos  ) {
+			return pos;
+		}
+	}
+	return NO_PACKET;
+}
+
+
+void freight_store_t::compact()
+{
+	uint32 kept = 0;
+	for(  uint32 pos = 0;  pos < packets.get_count();  pos++  ) {
+		if(  packets[pos].menge > 0  ) {
+			packets[kept++] = packets[pos];
+		}
+	}
+	while(  packets.get_count() > kept  ) {
+		packets.pop_back();
+	}
+	removed = 0;
+	rebuild();
+}
+
+
+void freight_store_t::rebuild()
+{
+	FOR(vector_tpl<via_t *>, via, vias) {
+		delete via;
+	}
+	vias.clear();
+	for(  uint32 pos = 0;  pos < packets.get_count();  pos++  ) {
+		add_to_via( pos );
+	}
+	rebuild_indices();
+}
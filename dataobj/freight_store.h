@@ -0,0 +1,122 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef DATAOBJ_FREIGHT_STORE_H
+#define DATAOBJ_FREIGHT_STORE_H
+
+
+#include "../simware.h"
+#include "../tpl/vector_tpl.h"
+
+
+/**
+ * Goods of one category waiting at a halt.
+ * The packets are kept contiguously in order of arrival. They are indexed by
+ * next transfer halt (zwischenziel), by destination (to merge packets) and by
+ * target position, so that loading and merging do not scan all packets.
+ *
+ * Emptied packets stay in place (they can still be merged with) until compact().
+ * Positions are valid until the next compact() or rebuild().
+ */
+class freight_store_t
+{
+public:
+	enum { NO_PACKET = 0xFFFFFFFFu };
+
+private:
+	/// all packets in order of arrival, may contain empty ones
+	vector_tpl<ware_t> packets;
+
+	/// number of packets emptied since the last compact()
+	uint32 removed;
+
+	/// positions of the packets with the same next transfer halt in ascending order
+	struct via_t
+	{
+		halthandle_t halt;
+		vector_tpl<uint32> positions;
+	};
+
+	/// sorted by halt id
+	vector_tpl<via_t *> vias;
+
+	/**
+	 * Open addressing hash tables holding position+1 (0 = free slot, REMOVED_ENTRY = emptied packet).
+	 * The destination index points to the newest non-empty packet of a key,
+	 * the zielpos index to the oldest one.
+	 * Entries of packets whose key changed are skipped when searching.
+	 */
+	uint32 *destination_index;
+	uint32 *zielpos_index;
+	/// position of the newest packet of each zielpos_index entry
+	uint32 *zielpos_last;
+	uint32 index_size;
+	uint32 index_entries;
+	uint32 zielpos_entries;
+
+	enum { REMOVED_ENTRY = 0xFFFFFFFFu };
+
+	/// for each packet the next newer one of the same goods and target position or NO_PACKET, may be empty
+	vector_tpl<uint32> zielpos_next;
+
+	static uint32 destination_hash(const ware_t &ware);
+	static uint32 zielpos_hash(uint8 index, koord zielpos);
+
+	via_t *get_or_add_via(halthandle_t halt);
+	void add_to_via(uint32 pos);
+	void add_to_indices(uint32 pos, bool only_destination);
+	void rebuild_indices();
+
+	freight_store_t(const freight_store_t &);
+	freight_store_t &operator=(const freight_store_t &);
+
+public:
+	freight_store_t();
+	~freight_store_t();
+
+	/// number of packets, including empty ones
+	uint32 get_count() const { return packets.get_count(); }
+	bool empty() const { return packets.empty(); }
+
+	/// packets in order of arrival; call update() after changing ziel or zwischenziel
+	ware_t &operator[](uint32 pos) { return packets[pos]; }
+	const ware_t &operator[](uint32 pos) const { return packets[pos]; }
+
+	void append(const ware_t &ware);
+
+	/// empties the packet at @p pos and drops it from the indices, it is dropped from the packets by the next compact()
+	void remove(uint32 pos);
+
+	/// registers the new ziel and zwischenziel of the packet at @p pos
+	void update(uint32 pos);
+
+	/// @returns position of a non-empty packet with the same destination (see ware_t::same_destination) or NO_PACKET
+	uint32 find_same_destination(const ware_t &ware) const;
+
+	/// @returns position of the first non-empty packet of goods type @p index to @p zielpos or NO_PACKET
+	uint32 find_zielpos(uint8 index, koord zielpos) const;
+
+	/**
+	 * @returns positions of the packets for next transfer halt @p halt in order of arrival or NULL.
+	 * Can contain positions of packets which go elsewhere meanwhile, check their zwischenziel.
+	 */
+	const vector_tpl<uint32> *get_via(halthandle_t halt) const;
+
+	/// forgets the positions of packets which no longer go via @p halt or are empty
+	void prune_via(halthandle_t halt);
+
+	/// true, if many packets were emptied
+	bool needs_compaction() const { return removed > 16  &&  removed*2 > packets.get_count(); }
+
+	/// drops the empty packets and rebuilds the indices
+	void compact();
+
+	/// rebuilds the indices, needed after changing the target of many packets
+	void rebuild();
+
+	void clear();
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef DATAOBJ_LOADING_PLAN_H
+#define DATAOBJ_LOADING_PLAN_H
+
+
+#include "../halthandle_t.h"
+#include "../tpl/vector_tpl.h"
+
+
+/**
+ * The waiting packets a convoi can load at a halt, in loading order, for each category.
+ * A category is planned on its first request and then used by all vehicles of the convoi.
+ * Valid until end_loading() of the halt.
+ */
+class loading_plan_t
+{
+	friend class haltestelle_t;
+
+	struct entry_t
+	{
+		uint32 pos;
+		/// next transfer halt of the packet when planned
+		halthandle_t via;
+
+		static bool compare(const entry_t &a, const entry_t &b) { return a.pos < b.pos; }
+	};
+
+	struct category_t
+	{
+		vector_tpl<entry_t> entries;
+		/// the entries before are used up
+		uint32 next;
+
+		category_t() : next(0) {}
+	};
+
+	/// indexed by category, NULL if not planned yet
+	vector_tpl<category_t *> categories;
+
+	loading_plan_t(const loading_plan_t &);
+	loading_plan_t &operator=(const loading_plan_t &);
+
+public:
+	loading_plan_t() {}
+
+	~loading_plan_t()
+	{
+		FOR(vector_tpl<category_t *>, category, categories) {
+			delete category;
+		}
+	}
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "../simdebug.h"
 #include "../utils/plainstring.h"
 #include "../utils/simstring.h"
+#include "../tpl/quickstone_tpl.h"
 
 #include "loadsave.h"
 
@@ -799,6 +800,22 @@ void loadsave_t::rdwr_long(uint32 &l)
 }
 
 
+void loadsave_t::rdwr_handle_id(uint32 &id)
+{
+	if(  get_OTRP_version() >= 34  ) {
+		rdwr_long(id);
+		if(  is_loading()  &&  id > QUICKSTONE_MAX_ID  ) {
+			dbg->fatal( "loadsave_t::rdwr_handle_id()", "Handle index %u is too large, the game needs a build with QUICKSTONE_32BIT", id );
+		}
+	}
+	else {
+		uint16 id16 = id;
+		rdwr_short(id16);
+		id = id16;
+	}
+}
+
+
 void loadsave_t::rdwr_longlong(sint64 &ll)
 {
 	if(!is_xml()) {
@@ -151,6 +151,8 @@ public:
 	void rdwr_long(sint32 &i);
 	void rdwr_long(uint32 &i);
 	void rdwr_longlong(sint64 &i);
+	/// index of a halt, convoi or line handle, 32 bit since OTRP version 34
+	void rdwr_handle_id(uint32 &id);
 	void rdwr_bool(bool &i);
 	void rdwr_double(double &dbl);
 
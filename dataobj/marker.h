@@ -13,7 +13,7 @@ class grund_t;
 
 /**
  * Class to mark tiles as visited during route search.
- * Singleton.
+ * Usually used as singleton, searches running in parallel need their own instance.
  */
 class marker_t {
 	// added bit mask, because it allows a more efficient
@@ -35,7 +35,10 @@ class marker_t {
 	/// hashtable to mark non-ground tiles (bridges, tunnels)
 	ptrhashtable_tpl <const grund_t *, bool> more;
 
-	marker_t() : bits(NULL) { init(0, 0); }
+	/// the instance
+	static marker_t the_instance;
+public:
+	marker_t() : bits(NULL), bits_length(0) { init(0, 0); }
 	~marker_t();
 
 	/**
@@ -45,10 +48,6 @@ class marker_t {
 	 */
 	void init(int world_size_x, int world_size_y);
 
-	/// the instance
-	static marker_t the_instance;
-	static marker_t second_instance;
-public:
 	/**
 	 * Return handle to marker instance.
 	 * @param world_size_x x-size of map
@@ -57,14 +56,6 @@ public:
 	 */
 	static marker_t& instance(int world_size_x, int world_size_y);
 
-	/**
-	 * Return handle to marker instance.
-	 * @param world_size_x x-size of map
-	 * @param world_size_y y-size of map
-	 * @returns handle to the singleton instance
-	 */
-	static marker_t& instance_second(int world_size_x, int world_size_y);
-
 	/**
 	 * Marks tile as visited.
 	 */
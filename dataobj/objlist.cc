@@ -203,6 +203,7 @@ objlist_t::objlist_t()
 	obj.one = NULL;
 	capacity = 0;
 	top = 0;
+	changes = 0;
 }
 
 
@@ -330,6 +331,7 @@ inline void objlist_t::intern_insert_at(obj_t* new_obj, uint8 pri)
 	}
 	obj.some[pri] = new_obj;
 	top++;
+	changes++;
 }
 
 
@@ -341,6 +343,7 @@ bool objlist_t::append(obj_t *new_obj)
 		obj.one = new_obj;
 		top = 1;
 		capacity = 1;
+		changes++;
 		return true;
 	}
 
@@ -434,6 +437,7 @@ void objlist_t::sort_trees(uint8 index, uint8 count)
 {
 	if(top>=index+count) {
 		std::sort(&obj.some[index], &obj.some[index+count], compare_trees);
+		changes++;
 	}
 }
 
@@ -445,6 +449,7 @@ bool objlist_t::add(obj_t* new_obj)
 		obj.one = new_obj;
 		top = 1;
 		capacity = 1;
+		changes++;
 		return true;
 	}
 
@@ -482,6 +487,7 @@ bool objlist_t::add(obj_t* new_obj)
 	if(i==top) {
 		obj.some[top] = new_obj;
 		top++;
+		changes++;
 	}
 	else {
 		if(pri==PRI_TREE) {
@@ -539,6 +545,7 @@ obj_t *objlist_t::remove_last()
 			obj.some[top] = NULL;
 		}
 	}
+	changes++;
 	return last_obj;
 }
 
@@ -553,6 +560,7 @@ bool objlist_t::remove(const obj_t* remove_obj)
 			obj.one = NULL;
 			capacity = 0;
 			top = 0;
+			changes++;
 			return true;
 		}
 		return false;
@@ -568,6 +576,7 @@ bool objlist_t::remove(const obj_t* remove_obj)
 				i++;
 			}
 			obj.some[top] = NULL;
+			changes++;
 			return true;
 		}
 	}
@@ -623,6 +632,7 @@ bool objlist_t::loesche_alle(player_t *player, uint8 offset)
 			capacity = top = 0;
 		}
 	}
+	changes++;
 	shrink_capacity(top);
 
 	return ok;
@@ -40,6 +40,12 @@ private:
 	 */
 	uint8 top;
 
+	/**
+	 * Incremented whenever objects are added, removed or reordered,
+	 * so caches of the contents can tell if they are outdated
+	 */
+	uint32 changes;
+
 	void set_capacity(uint16 new_cap);
 
 	bool grow_capacity();
@@ -92,6 +98,8 @@ public:
 
 	inline uint8 get_top() const {return top;}
 
+	inline uint32 get_changes() const {return changes;}
+
 	/**
 	 * sorts the trees according to their offsets
 	 */
@@ -20,23 +20,45 @@
 #include "environment.h"
 #include "../vehicle/simvehicle.h"
 
-// define USE_VALGRIND_MEMCHECK to make
-// valgrind aware of the memory pool for A* nodes
-#ifdef USE_VALGRIND_MEMCHECK
-#include <valgrind/memcheck.h>
-#endif
-
 // if defined, print some profiling informations into the file
 //#define DEBUG_ROUTES
 
 // binary heap, the fastest
 #include "../tpl/binary_heap_tpl.h"
+#include "../utils/for.h"
 
 
 #ifdef DEBUG_ROUTES
 #include "../sys/simsys.h"
 #endif
 
+#ifdef MULTI_THREAD
+#include "../utils/simthread.h"
+static pthread_mutex_t search_context_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// contexts not in use, kept for the next searches
+static vector_tpl<route_t::search_context_t *> free_search_contexts;
+
+/**
+ * Result of a search in calc_route(), before stretching it into a halt.
+ */
+struct route_cache_entry_t {
+	koord3d start;
+	koord3d ziel;
+	sint32 max_speed;
+	uint64 driver_id;
+	/// weg_t::get_generation() of the waytype when searched, outdated if different
+	uint32 generation;
+	bool found;
+	koord3d_vector_t route;
+};
+
+// the least recently used first; only accessed from the main thread
+static vector_tpl<route_cache_entry_t *> route_cache;
+static uint32 route_cache_hits = 0;
+static uint32 route_cache_misses = 0;
+
 
 void route_t::append(const route_t *r)
 {
@@ -105,17 +127,84 @@ bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 
 
 
-// node arrays
-route_t::ANode* route_t::nodes=NULL;
-uint32 route_t::MAX_STEP=0;
-#ifdef DEBUG
-bool route_t::node_in_use=false;
+route_t::search_context_t::~search_context_t()
+{
+	FOR(vector_tpl<ANode *>, const block, blocks) {
+		delete [] block;
+	}
+}
+
+
+void route_t::search_context_t::reset(karte_t *welt)
+{
+	marker.init( welt->get_size().x, welt->get_size().y );
+	queue.clear();
+}
+
+
+route_t::search_context_holder_t::search_context_holder_t(bool interruptible)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &search_context_mutex );
+#endif
+	ctx = free_search_contexts.empty() ? new search_context_t(interruptible) : free_search_contexts.pop_back();
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &search_context_mutex );
+#endif
+	ctx->interruptible = interruptible;
+}
+
+
+route_t::search_context_holder_t::~search_context_holder_t()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &search_context_mutex );
 #endif
+	// one per thread and one for a search nested in INT_CHECK, more were only needed at a peak
+	if(  free_search_contexts.get_count() <= env_t::num_threads  ) {
+		free_search_contexts.append( ctx );
+		ctx = NULL;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &search_context_mutex );
+#endif
+	delete ctx;
+}
+
 
 /**
  * find the route to an unknown location
  */
-bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling )
+// the tiles from the start to @p node
+static void store_route(koord3d_vector_t &route, const route_t::ANode *node)
+{
+	route.clear();
+	route.store_at( node->count, node->gr->get_pos() );
+	while(node != NULL) {
+		route[ node->count ] = node->gr->get_pos();
+		node = node->parent;
+	}
+}
+
+
+bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling, search_context_t *ctx )
+{
+	if(  ctx == NULL  ) {
+		search_context_holder_t holder;
+		return find_route( welt, start, tdriver, max_khm, start_dir, max_depth, coupling, &*holder );
+	}
+	return intern_find_route( welt, start, tdriver, max_khm, start_dir, max_depth, coupling, *ctx, NULL );
+}
+
+
+bool route_t::find_all_routes(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, vector_tpl<koord3d_vector_t *> &routes)
+{
+	search_context_holder_t holder;
+	return intern_find_route( welt, start, tdriver, max_khm, start_dir, max_depth, false, *holder, &routes );
+}
+
+
+bool route_t::intern_find_route(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling, search_context_t &ctx, vector_tpl<koord3d_vector_t *> *all_routes)
 {
 	bool ok = false;
 
@@ -128,14 +217,10 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 	// some thing for the search
 	const waytype_t wegtyp = tdriver->get_waytype();
 
-	// memory in static list ...
-	if(  nodes == NULL  ) {
-		MAX_STEP = welt->get_settings().get_max_route_steps();
-		nodes = new ANode[MAX_STEP];
+	if(  ctx.interruptible  ) {
+		INT_CHECK("route 347");
 	}
 
-	INT_CHECK("route 347");
-
 	// we clear it here probably twice: does not hurt ...
 	route.clear();
 
@@ -144,16 +229,13 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 		return false;
 	}
 
-	static binary_heap_tpl <ANode *> queue;
-
-	GET_NODE();
-#ifdef USE_VALGRIND_MEMCHECK
-	VALGRIND_MAKE_MEM_UNDEFINED(nodes, sizeof(ANode)*MAX_STEP);
-#endif
-
+	ctx.reset(welt);
+	binary_heap_tpl<ANode *> &queue = ctx.queue;
+	marker_t &marker = ctx.marker;
+	const uint32 max_step = welt->get_settings().get_max_route_steps();
 
 	uint32 step = 0;
-	ANode* tmp = &nodes[step++];
+	ANode* tmp = ctx.get_node(step++);
 	tmp->parent = NULL;
 	tmp->gr = g;
 	tmp->count = 0;
@@ -167,10 +249,6 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 	// assert that mask in first step is equal to start_dir
 	assert( (uint8)(~ribi_t::reverse_single(tmp->ribi_from)& 0xf)  == start_dir);
 
-	// nothing in lists
-	marker_t& marker = marker_t::instance(welt->get_size().x, welt->get_size().y);
-
-	queue.clear();
 	queue.insert(tmp);
 
 	bool target_reached = false;
@@ -202,6 +280,13 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 			already_there = tdriver->is_target( gr, tmp->parent==NULL ? NULL : tmp->parent->gr );
 		}
 		if(  already_there  ) {
+			if(  all_routes  ) {
+				// collect it and search on, but not through it to the next target
+				koord3d_vector_t *r = new koord3d_vector_t();
+				store_route( *r, tmp );
+				all_routes->append( r );
+				continue;
+			}
 			// we added a target to the closed list: check for length
 			target_reached = true;
 			break;
@@ -219,7 +304,7 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 			    && tdriver->check_next_tile(to, true) // can be driven on
 			) {
 				// not in there or taken out => add new
-				ANode* k = &nodes[step++];
+				ANode* k = ctx.get_node(step++);
 
 				k->parent = tmp;
 				k->gr = to;
@@ -250,35 +335,29 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 			}
 		}
 
-	} while(  !queue.empty()  &&  step < MAX_STEP  &&  queue.get_count() < max_depth  );
+	} while(  !queue.empty()  &&  step < max_step  &&  queue.get_count() < max_depth  );
 
 	INT_CHECK("route 194");
 
-	// target reached?
-	if(!target_reached  ||  step >= MAX_STEP) {
-		if(  step >= MAX_STEP  ) {
-			dbg->warning("route_t::find_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,MAX_STEP);
-		}
+	if(  step >= max_step  ) {
+		dbg->warning("route_t::find_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,max_step);
 	}
-	else {
+	if(  all_routes  ) {
+		ok = !all_routes->empty();
+	}
+	else if(  target_reached  &&  step < max_step  ) {
 		// reached => construct route
-		route.store_at( tmp->count, tmp->gr->get_pos() );
-		while(tmp != NULL) {
-			route[ tmp->count ] = tmp->gr->get_pos();
-			tmp = tmp->parent;
-		}
+		store_route( route, tmp );
 		ok = !route.empty();
 	}
 
-	RELEASE_NODE();
 	return ok;
 }
 
 
 
-ribi_t::ribi *get_next_dirs(const koord3d& gr_pos, const koord3d& ziel)
+static void get_next_dirs(const koord3d& gr_pos, const koord3d& ziel, ribi_t::ribi *next_ribi)
 {
-	static ribi_t::ribi next_ribi[4];
 	if( abs(gr_pos.x-ziel.x)>abs(gr_pos.y-ziel.y) ) {
 		next_ribi[0] = (ziel.x>gr_pos.x) ? ribi_t::east : ribi_t::west;
 		next_ribi[1] = (ziel.y>gr_pos.y) ? ribi_t::south : ribi_t::north;
@@ -289,12 +368,39 @@ ribi_t::ribi *get_next_dirs(const koord3d& gr_pos, const koord3d& ziel)
 	}
 	next_ribi[2] = ribi_t::reverse_single( next_ribi[1] );
 	next_ribi[3] = ribi_t::reverse_single( next_ribi[0] );
-	return next_ribi;
 }
 
 
 
-bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_speed, const uint32 max_cost)
+/**
+ * Extra cost for a curve when going from @p tmp in direction @p dir.
+ * @param[out] current_dir the driving direction on the next tile
+ */
+static uint32 get_turn_cost(const route_t::ANode *tmp, ribi_t::ribi dir, uint8 &current_dir)
+{
+	if(  tmp->parent==NULL  ) {
+		current_dir = dir;
+		return 0;
+	}
+	uint32 cost = 0;
+	current_dir = dir | tmp->ribi_from;
+	if(tmp->dir!=current_dir) {
+		cost += 3;
+		if(tmp->parent->dir!=tmp->dir  &&  tmp->parent->parent!=NULL) {
+			// discourage 90 degree turns
+			cost += 10;
+		}
+		else if(ribi_t::is_perpendicular(tmp->dir,current_dir)) {
+			// discourage v turns heavily
+			cost += 25;
+		}
+	}
+	return cost;
+}
+
+
+
+bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_speed, const uint32 max_cost, search_context_t &ctx)
 {
 	bool ok = false;
 
@@ -332,23 +438,18 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 
 	bool ziel_erreicht=false;
 
-	// memory in static list ...
-	if(  nodes == NULL  ) {
-		MAX_STEP = welt->get_settings().get_max_route_steps(); // may need very much memory => configurable
-		nodes = new ANode[MAX_STEP + 4 + 2];
+	if(  ctx.interruptible  ) {
+		INT_CHECK("route 347");
 	}
 
-	INT_CHECK("route 347");
-
-	static binary_heap_tpl <ANode *> queue;
-
-	GET_NODE();
-#ifdef USE_VALGRIND_MEMCHECK
-	VALGRIND_MAKE_MEM_UNDEFINED(nodes, sizeof(ANode)*MAX_STEP);
-#endif
+	// clear the queue and the closed list
+	ctx.reset(welt);
+	binary_heap_tpl<ANode *> &queue = ctx.queue;
+	marker_t &marker = ctx.marker;
+	const uint32 max_step = welt->get_settings().get_max_route_steps(); // configurable
 
 	uint32 step = 0;
-	ANode* tmp = &nodes[step];
+	ANode* tmp = ctx.get_node(step);
 	step ++;
 
 	tmp->parent = NULL;
@@ -360,18 +461,14 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 	tmp->ribi_from = ribi_t::none;
 	tmp->jps_ribi  = ribi_t::all;
 
-	// nothing in lists
-	marker_t& marker = marker_t::instance(welt->get_size().x, welt->get_size().y);
-
-	// clear the queue (should be empty anyhow)
-	queue.clear();
 	queue.insert(tmp);
 	ANode* new_top = NULL;
+	ribi_t::ribi next_ribi[4];
 
 	uint32 beat=1;
 	do {
 		// this is too expensive to be called each step
-		if((beat++ & 4095) == 0) {
+		if(  (beat++ & 4095) == 0  &&  ctx.interruptible  ) {
 			INT_CHECK("route 161");
 		}
 
@@ -405,7 +502,7 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 		// mask direction we came from
 		const ribi_t::ribi ribi =  way_ribi  &  ( ~ribi_t::reverse_single(tmp->ribi_from) )  &  tmp->jps_ribi;
 
-		const ribi_t::ribi *next_ribi = get_next_dirs(gr->get_pos(), ziel);
+		get_next_dirs(gr->get_pos(), ziel, next_ribi);
 		for(int r=0; r<4; r++) {
 
 			// a way in our direction?
@@ -436,31 +533,59 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 				// check for curves (usually, one would need the lastlast and the last;
 				// if not there, then we could just take the last
 				uint8 current_dir;
-				if(tmp->parent!=NULL) {
-					current_dir = next_ribi[r] | tmp->ribi_from;
-					if(tmp->dir!=current_dir) {
-						new_g += 3;
-						if(tmp->parent->dir!=tmp->dir  &&  tmp->parent->parent!=NULL) {
-							// discourage 90 degree turns
-							new_g += 10;
-						}
-						else if(ribi_t::is_perpendicular(tmp->dir,current_dir)) {
-							// discourage v turns heavily
-							new_g += 25;
-						}
-					}
+				new_g += get_turn_cost( tmp, next_ribi[r], current_dir );
 
+				// add new
+				ANode* k = ctx.get_node(step);
+				step ++;
+
+				k->parent = tmp;
+				k->gr = to;
+				k->g = new_g;
+				k->dir = current_dir;
+				k->ribi_from = next_ribi[r];
+				k->count = tmp->count+1;
+				k->jps_ribi = ribi_t::all;
+
+				// Follow the way up to the next junction: a tile with only one way onwards
+				// needs no entry in the open list, so only junctions are sorted into the queue.
+				// The tiles in between are still checked for this driver and get their node for the route.
+				while(  !use_jps  &&  !is_airplane  &&  k->gr->get_pos() != ziel  &&  step < max_step  ) {
+					const grund_t *from = k->gr;
+					const ribi_t::ribi onwards = tdriver->get_ribi(from) & ~ribi_t::reverse_single(k->ribi_from);
+					grund_t *next = NULL;
+					if(  !ribi_t::is_single(onwards)  ||  !from->get_neighbour(next, wegtyp, onwards)  ||  !tdriver->check_next_tile(next)  ||  marker.is_marked(next)  ) {
+						break;
+					}
+					weg_t *next_w = next->get_weg(wegtyp);
+					if(  next_w  &&  next_w->get_ribi_maske()  &&  ribi_t::reverse_single(onwards) == next_w->get_ribi()  ) {
+						// oneway sign against us, see above
+						break;
+					}
+					// no other way leads on from here
+					marker.mark(from);
+
+					ANode* n = ctx.get_node(step);
+					step ++;
+
+					n->parent = k;
+					n->gr = next;
+					n->g = k->g + (next_w ? tdriver->get_cost(next, next_w, max_speed, onwards) : 1) + get_turn_cost( k, onwards, n->dir );
+					n->f = n->g + calc_distance( next->get_pos(), ziel );
+					n->ribi_from = onwards;
+					n->count = k->count+1;
+					n->jps_ribi = ribi_t::all;
+					k = n;
 				}
-				else {
-					current_dir = next_ribi[r];
-				}
+				const grund_t *end = k->gr;
+				current_dir = k->dir;
 
-				uint32 dist = calc_distance( to->get_pos(), ziel );
+				uint32 dist = calc_distance( end->get_pos(), ziel );
 
 				// count how many 45 degree turns are necessary to get to target
 				sint8 turns = 0;
 				if (dist>1) {
-					ribi_t::ribi to_target = ribi_type(to->get_pos(), ziel );
+					ribi_t::ribi to_target = ribi_type(end->get_pos(), ziel );
 
 					if (to_target  &&  (to_target!=current_dir)) {
 						if (ribi_t::is_single(current_dir) != ribi_t::is_single(to_target)) {
@@ -479,23 +604,11 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 				// take height difference into account when calculating distance
 				uint32 costup = 0;
 				if (cost_upslope) {
-					costup = cost_upslope * max(ziel.z - to->get_vmove(next_ribi[r]), 0);
+					costup = cost_upslope * max(ziel.z - end->get_vmove(k->ribi_from), 0);
 				}
 
-				const uint32 new_f = new_g + dist + turns * 3 + costup;
-
-				// add new
-				ANode* k = &nodes[step];
-				step ++;
-
-				k->parent = tmp;
-				k->gr = to;
-				k->g = new_g;
+				const uint32 new_f = k->g + dist + turns * 3 + costup;
 				k->f = new_f;
-				k->dir = current_dir;
-				k->ribi_from = next_ribi[r];
-				k->count = tmp->count+1;
-				k->jps_ribi = ribi_t::all;
 
 				if (use_jps  &&  to->is_water()) {
 					// only check previous direction plus directions not available on this tile
@@ -526,19 +639,21 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 			}
 		}
 
-	} while (  (!queue.empty() ||  new_top)  &&  step < MAX_STEP  &&  tmp->g < max_cost  );
+	} while (  (!queue.empty() ||  new_top)  &&  step < max_step  &&  tmp->g < max_cost  );
 
 #ifdef DEBUG_ROUTES
 	// display marked route
 	// minimap_t::get_instance()->calc_map();
-	DBG_DEBUG("route_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u (max %u)",step,MAX_STEP,queue.get_count(),tmp->g,max_cost);
+	DBG_DEBUG("route_t::intern_calc_route()","steps=%i  (max %i) in route, open %i, cost %u (max %u)",step,max_step,queue.get_count(),tmp->g,max_cost);
 #endif
 
-	INT_CHECK("route 194");
+	if(  ctx.interruptible  ) {
+		INT_CHECK("route 194");
+	}
 	// target reached?
-	if(!ziel_erreicht  || step >= MAX_STEP  ||  tmp->g >= max_cost  ||  tmp->parent==NULL) {
-		if(  step >= MAX_STEP  ) {
-			dbg->warning("route_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,MAX_STEP);
+	if(!ziel_erreicht  || step >= max_step  ||  tmp->g >= max_cost  ||  tmp->parent==NULL) {
+		if(  step >= max_step  ) {
+			dbg->warning("route_t::intern_calc_route()","Too many steps (%i>=max %i) in route (too long/complex)",step,max_step);
 		}
 	}
 	else {
@@ -565,8 +680,6 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 		ok = true;
 	}
 
-	RELEASE_NODE();
-
 	return ok;
 }
 
@@ -681,23 +794,112 @@ void route_t::postprocess_water_route(karte_t *welt)
  * searches route, uses intern_calc_route() for distance between stations
  * handles only driving in stations by itself
  */
-route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_khm, sint32 max_len )
+static void copy_tiles(koord3d_vector_t &dest, const koord3d_vector_t &src)
+{
+	dest.clear();
+	dest.resize( src.get_count() );
+	FOR(koord3d_vector_t, const& k, src) {
+		dest.append( k );
+	}
+}
+
+
+void route_t::clear_cache()
 {
+	FOR(vector_tpl<route_cache_entry_t *>, const e, route_cache) {
+		delete e;
+	}
+	route_cache.clear();
+}
+
+
+void route_t::get_cache_statistics(uint32 &hits, uint32 &misses)
+{
+	hits = route_cache_hits;
+	misses = route_cache_misses;
+	route_cache_hits = route_cache_misses = 0;
+}
+
+
+route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_khm, sint32 max_len, search_context_t *ctx )
+{
+	if(  ctx == NULL  ) {
+		search_context_holder_t holder;
+		return calc_route( welt, ziel, start, tdriver, max_khm, max_len, &*holder );
+	}
+
 	route.clear();
 
-	INT_CHECK("route 336");
+	if(  ctx->interruptible  ) {
+		INT_CHECK("route 336");
+	}
 
 #ifdef DEBUG_ROUTES
 	const uint32 ms = dr_time();
 #endif
-	bool ok = intern_calc_route(welt, start, ziel, tdriver, max_khm, 0xFFFFFFFFul );
+	// worker threads do not use the cache, their searches give the same result anyway
+	uint64 driver_id;
+	const bool use_cache = ctx->interruptible  &&  env_t::route_cache_size > 0  &&  tdriver->get_route_cache_id( driver_id );
+	const uint32 generation = use_cache ? weg_t::get_generation( tdriver->get_waytype() ) : 0;
+
+	bool ok = false;
+	route_cache_entry_t *cached = NULL;
+	if(  use_cache  ) {
+		for(  uint32 i = route_cache.get_count();  i-- > 0;  ) {
+			route_cache_entry_t *e = route_cache[i];
+			if(  e->start == start  &&  e->ziel == ziel  &&  e->max_speed == max_khm  &&  e->driver_id == driver_id  ) {
+				route_cache.remove_at( i );
+				if(  e->generation == generation  ) {
+					// used again => move to the end
+					route_cache.append( e );
+					cached = e;
+				}
+				else {
+					// the ways have changed since
+					delete e;
+				}
+				break;
+			}
+		}
+	}
+
+	if(  cached  ) {
+		route_cache_hits++;
+		copy_tiles( route, cached->route );
+		ok = cached->found;
+	}
+	else {
+		ok = intern_calc_route(welt, start, ziel, tdriver, max_khm, 0xFFFFFFFFul, *ctx );
+		if(  use_cache  &&  generation == weg_t::get_generation( tdriver->get_waytype() )  ) {
+			route_cache_misses++;
+			route_cache_entry_t *e;
+			if(  route_cache.get_count() >= env_t::route_cache_size  ) {
+				// drop the least recently used
+				e = route_cache[0];
+				route_cache.remove_at( 0 );
+			}
+			else {
+				e = new route_cache_entry_t;
+			}
+			e->start = start;
+			e->ziel = ziel;
+			e->max_speed = max_khm;
+			e->driver_id = driver_id;
+			e->generation = generation;
+			e->found = ok;
+			copy_tiles( e->route, route );
+			route_cache.append( e );
+		}
+	}
 #ifdef DEBUG_ROUTES
 	if(tdriver->get_waytype()==water_wt) {
 		DBG_DEBUG("route_t::calc_route()", "route from %d,%d to %d,%d with %i steps in %u ms found.", start.x, start.y, ziel.x, ziel.y, route.get_count()-1, dr_time()-ms );
 	}
 #endif
 
-	INT_CHECK("route 343");
+	if(  ctx->interruptible  ) {
+		INT_CHECK("route 343");
+	}
 
 	if( !ok ) {
 		DBG_MESSAGE("route_t::calc_route()","No route from %d,%d to %d,%d found",start.x, start.y, ziel.x, ziel.y);
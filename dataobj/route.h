@@ -10,8 +10,10 @@
 #include "../simdebug.h"
 
 #include "../dataobj/koord3d.h"
+#include "../dataobj/marker.h"
 
 #include "../tpl/vector_tpl.h"
+#include "../tpl/binary_heap_tpl.h"
 
 
 class karte_t;
@@ -27,11 +29,18 @@ class route_t
 public:
 	static const uint16 INVALID_INDEX = 0xFFFA;
 
+	class search_context_t;
+
 private:
 	/**
 	 * The actual route search
 	 */
-	bool intern_calc_route(karte_t *w, koord3d start, koord3d ziel, test_driver_t *tdriver, const sint32 max_kmh, const uint32 max_cost);
+	bool intern_calc_route(karte_t *w, koord3d start, koord3d ziel, test_driver_t *tdriver, const sint32 max_kmh, const uint32 max_cost, search_context_t &ctx);
+
+	/**
+	 * The search of find_route(), if @p all_routes is not NULL it collects the routes to all targets
+	 */
+	bool intern_find_route(karte_t *w, koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling, search_context_t &ctx, vector_tpl<koord3d_vector_t *> *all_routes);
 
 	koord3d_vector_t route;           // The coordinates for the vehicle route
 
@@ -67,17 +76,56 @@ public:
 		inline bool operator <= (const ANode &k) const { return f==k.f ? g<=k.g : f<=k.f; }
 	};
 
-	static ANode *nodes;
-	static uint32 MAX_STEP;
-#ifdef DEBUG
-	// a semaphore, since we only have a single version of the array in memory
-	static bool node_in_use;
-	static void GET_NODE() {if(node_in_use){ dbg->fatal("GET_NODE","called while list in use");} node_in_use =1; }
-	static void RELEASE_NODE() {if(!node_in_use){ dbg->fatal("RELEASE_NODE","called while list free");} node_in_use =0; }
-#else
-	static void GET_NODE() {}
-	static void RELEASE_NODE() {}
-#endif
+	/**
+	 * Memory needed by a single search: the nodes, the open list and the closed list.
+	 * Searches with different contexts can run at the same time in different threads.
+	 */
+	class search_context_t {
+		enum { BLOCK_SHIFT = 12, BLOCK_SIZE = 1 << BLOCK_SHIFT };
+
+		/// nodes are allocated in blocks when needed, so pointers to them stay valid
+		vector_tpl<ANode *> blocks;
+
+	public:
+		binary_heap_tpl<ANode *> queue;
+		marker_t marker;
+
+		/// second closed list, only for elevated ways in way_builder_t (not cleared by reset())
+		marker_t upper_marker;
+
+		/// false for worker threads, which must not call INT_CHECK
+		bool interruptible;
+
+		search_context_t(bool interruptible) : interruptible(interruptible) {}
+		~search_context_t();
+
+		/// clears open and closed list for a new search
+		void reset(karte_t *welt);
+
+		ANode *get_node(uint32 n)
+		{
+			while(  (n >> BLOCK_SHIFT) >= blocks.get_count()  ) {
+				blocks.append( new ANode[BLOCK_SIZE] );
+			}
+			return blocks[n >> BLOCK_SHIFT] + (n & (BLOCK_SIZE-1));
+		}
+	};
+
+	/**
+	 * Lends a search context for its lifetime. The contexts are pooled, but
+	 * every search (nested in INT_CHECK or in another thread) gets its own one.
+	 */
+	class search_context_holder_t {
+		search_context_t *ctx;
+
+	public:
+		/// @param interruptible false in worker threads
+		explicit search_context_holder_t(bool interruptible = true);
+		~search_context_holder_t();
+
+		search_context_t &operator*() const { return *ctx; }
+		search_context_t *operator->() const { return ctx; }
+	};
 
 	const koord3d_vector_t &get_route() const { return route; }
 
@@ -132,16 +180,42 @@ public:
 	 */
 	bool append_straight_route( karte_t *w, koord3d target);
 
+	/**
+	 * Exchanges the tiles of both routes.
+	 */
+	void swap(route_t &other) { ::swap( route, other.route ); }
+
 	/**
 	 * Finds route to a location, where @p tdriver->is_target becomes true.
 	 * @param max_depth is the maximum length of a route
+	 * @param ctx memory for the search, a free one from the pool if NULL
 	 */
-	bool find_route(karte_t *w, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling = false);
+	bool find_route(karte_t *w, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, bool coupling = false, search_context_t *ctx = NULL);
+
+	/**
+	 * Finds the cheapest route to each location in reach where @p tdriver->is_target becomes true,
+	 * without passing other targets. The routes are appended to @p routes cheapest first,
+	 * the caller must delete them. This route is cleared.
+	 * @returns true if at least one route was found
+	 */
+	bool find_all_routes(karte_t *w, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth, vector_tpl<koord3d_vector_t *> &routes);
 
 	/**
 	 * Calculates the route from @p start to @p target
+	 * @param ctx memory for the search, a free one from the pool if NULL
+	 */
+	route_result_t calc_route(karte_t *welt, koord3d start, koord3d target, test_driver_t *tdriver, const sint32 max_speed_kmh, sint32 max_tile_len, search_context_t *ctx = NULL );
+
+	/**
+	 * Searches repeated by calc_route() since the last call, to size route_cache_size.
+	 * Resets the counters.
+	 */
+	static void get_cache_statistics(uint32 &hits, uint32 &misses);
+
+	/**
+	 * Forgets all cached searches, e.g. when the world is destroyed.
 	 */
-	route_result_t calc_route(karte_t *welt, koord3d start, koord3d target, test_driver_t *tdriver, const sint32 max_speed_kmh, sint32 max_tile_len );
+	static void clear_cache();
 
 	/**
 	 * Load/Save of the route.
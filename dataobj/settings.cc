@@ -304,10 +304,12 @@ settings_t::settings_t() :
 	citycar_route_weight_crowded = 20;
 	citycar_route_weight_vacant = 100;
 	citycar_route_weight_speed = 0;
+	citycar_detail_distance = 0;
 	
 	advance_to_end = true;
 	first_come_first_serve = false;
 	waiting_limit_for_first_come_first_serve = 500000;
+	transfer_table_memory = 0;
 	
 	routecost_wait = 8;
 	routecost_halt = 1;
@@ -915,6 +917,12 @@ void settings_t::rdwr(loadsave_t *file)
 			file->rdwr_short(citycar_route_weight_vacant);
 			file->rdwr_short(citycar_route_weight_speed);
 		}
+		if(  file->get_OTRP_version() >= 35  ) {
+			file->rdwr_short(citycar_detail_distance);
+		}
+		else if(  file->is_loading()  ) {
+			citycar_detail_distance = 0;
+		}
 		if(  file->is_version_atleast(120, 7)  ) {
 			file->rdwr_byte(world_maximum_height);
 			file->rdwr_byte(world_minimum_height);
@@ -944,6 +952,12 @@ void settings_t::rdwr(loadsave_t *file)
 		if(  file->get_OTRP_version() >= 31  ) {
 			file->rdwr_long(waiting_limit_for_first_come_first_serve);
 		}
+		if(  file->get_OTRP_version() >= 33  ) {
+			file->rdwr_long(transfer_table_memory);
+		}
+		else if(  file->is_loading()  ) {
+			transfer_table_memory = 0;
+		}
 		if(  file->is_version_atleast(122, 1)  ) {
 			file->rdwr_enum(climate_generator);
 			file->rdwr_byte( wind_direction );
@@ -1049,6 +1063,12 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	env_t::simple_drawing_default      = contents.get_int_clamped( "simple_drawing_tile_size",       env_t::simple_drawing_default,    2, 256 );
 
 	env_t::simple_drawing_fast_forward = contents.get_int( "simple_drawing_fast_forward", env_t::simple_drawing_fast_forward ) != 0;
+	env_t::parallel_convoi_step        = contents.get_int( "parallel_convoi_step",        env_t::parallel_convoi_step ) != 0;
+	env_t::parallel_sync_step          = contents.get_int( "parallel_sync_step",          env_t::parallel_sync_step ) != 0;
+	env_t::parallel_reconnect          = contents.get_int( "parallel_reconnect",          env_t::parallel_reconnect ) != 0;
+	env_t::parallel_passenger_routing  = contents.get_int( "parallel_passenger_routing",  env_t::parallel_passenger_routing ) != 0;
+	env_t::parallel_factory_step       = contents.get_int( "parallel_factory_step",       env_t::parallel_factory_step ) != 0;
+	env_t::route_cache_size            = contents.get_int_clamped( "route_cache_size",    env_t::route_cache_size, 0, 65536 );
 	env_t::visualize_schedule          = contents.get_int( "visualize_schedule",          env_t::visualize_schedule ) != 0;
 
 	env_t::hide_rail_return_ticket  = contents.get_int( "hide_rail_return_ticket",   env_t::hide_rail_return_ticket ) != 0;
@@ -1626,11 +1646,13 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	citycar_route_weight_crowded = contents.get_int("citycar_route_weight_crowded", citycar_route_weight_crowded);
 	citycar_route_weight_vacant = contents.get_int("citycar_route_weight_vacant", citycar_route_weight_vacant);
 	citycar_route_weight_speed = contents.get_int("citycar_route_weight_speed", citycar_route_weight_speed);
+	citycar_detail_distance = contents.get_int_clamped("citycar_detail_distance", citycar_detail_distance, 0, 1000);
 	
 	advance_to_end = contents.get_int("advance_to_end", advance_to_end);
 	first_come_first_serve = contents.get_int("first_come_first_serve", first_come_first_serve);
 	waiting_limit_for_first_come_first_serve 
 		= contents.get_int("waiting_limit_for_first_come_first_serve", waiting_limit_for_first_come_first_serve);
+	transfer_table_memory = contents.get_int("transfer_table_memory", transfer_table_memory);
 	
 	routecost_wait = contents.get_int("routecost_wait", routecost_wait);
 	routecost_halt = contents.get_int("routecost_halt", routecost_halt);
@@ -323,6 +323,8 @@ private:
 	uint16 citycar_route_weight_crowded;
 	uint16 citycar_route_weight_vacant;
 	sint16 citycar_route_weight_speed;
+	// citycars farther than about this from halts and convoys are only counted, 0 = all simulated
+	uint16 citycar_detail_distance;
 	
 	// only for trains. If true, trains advance to the end of the platform.
 	bool advance_to_end;
@@ -333,6 +335,9 @@ private:
 	// first_come_first_serve is no longer applied to reduce the calculation load.
 	uint32 waiting_limit_for_first_come_first_serve;
 	
+	// memory in MB for precomputed routes between halts (0 = always search)
+	uint32 transfer_table_memory;
+	
 	// paramters for haltestelle_t::rebuild_connections()
 	uint8 routecost_halt;
 	uint8 routecost_wait;
@@ -684,6 +689,7 @@ public:
 	
 	uint16 get_citycar_max_look_forward() const { return citycar_max_look_forward; }
 	citycar_routing_param_t get_citycar_routing_param() const;
+	uint16 get_citycar_detail_distance() const { return citycar_detail_distance; }
 	
 	bool get_advance_to_end() const { return advance_to_end; }
 	void set_advance_to_end(bool b) { advance_to_end = b; }
@@ -692,6 +698,8 @@ public:
 	uint32 get_waiting_limit_for_first_come_first_serve() const 
 		{ return waiting_limit_for_first_come_first_serve; }
 	
+	uint32 get_transfer_table_memory() const { return transfer_table_memory; }
+	
 	uint8 get_routecost_halt() const { return routecost_halt; }
 	uint8 get_routecost_wait() const { return routecost_wait; }
 	
@@ -46,6 +46,9 @@
 // currently just redrawing/rezooming
 static pthread_mutex_t rezoom_img_mutex[MAX_THREADS];
 static pthread_mutex_t recode_img_mutex;
+
+// objects may mark their images dirty from several threads during sync_step
+static pthread_mutex_t tile_dirty_mutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 // to pass the extra clipnum when not needed use this
@@ -1049,7 +1052,13 @@ void mark_rect_dirty_wc(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2, sc
 		if(  y2 >= disp_height  ) {
 			y2 = disp_height - 1;
 		}
+#ifdef MULTI_THREAD
+		pthread_mutex_lock( &tile_dirty_mutex );
+#endif
 		mark_rect_dirty_nc( x1, y1, x2, y2 );
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock( &tile_dirty_mutex );
+#endif
 	}
 }
 
@@ -177,7 +177,7 @@ void factory_chart_t::set_factory(const fabrik_t *_factory)
 			for (uint32 g = 0; g < input_count; ++g) {
 				goods_cont.new_component<gui_label_t>(input[g].get_typ()->get_name());
 				for (int s = 0; s < MAX_FAB_GOODS_STAT; ++s) {
-					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + (s * 3) / 2), input[g].get_stats(), MAX_FAB_GOODS_STAT, s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
+					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + (s * 3) / 2), input[g].get_stats(), ware_production_t::get_stats_stride(), s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
 
 					button_t* b = goods_cont.new_component<button_t>();
 					b->init(button_t::box_state_automatic | button_t::flexible, input_type[s]);
@@ -202,7 +202,7 @@ void factory_chart_t::set_factory(const fabrik_t *_factory)
 			for (uint32 g = 0; g < output_count; ++g) {
 				goods_cont.new_component<gui_label_t>(output[g].get_typ()->get_name());
 				for (int s = 0; s < 3; ++s) {
-					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + s * 2), output[g].get_stats(), MAX_FAB_GOODS_STAT, s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
+					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + s * 2), output[g].get_stats(), ware_production_t::get_stats_stride(), s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
 
 					button_t* b = goods_cont.new_component<button_t>();
 					b->init(button_t::box_state_automatic | button_t::flexible, output_type[s]);
@@ -124,7 +124,7 @@ void factorylist_frame_t::fill_list()
 		}
 	}
 
-	FOR(const slist_tpl<fabrik_t *>,fab,world()->get_fab_list()) {
+	FOR(const vector_tpl<fabrik_t*>,fab,world()->get_fab_list()) {
 		if( pl == NULL  ||  fab->is_within_players_network( pl ) ) {
 			if(  name_filter[0] == 0  ||  utf8caseutf8(fab->get_name(), name_filter)) {
 				scrolly.new_component<factorylist_stats_t>( fab );
@@ -95,7 +95,7 @@ void factorylist_stats_t::set_size(scr_size size)
 
 bool factorylist_stats_t::is_valid() const
 {
-	return world()->get_fab_list().is_contained(fab);
+	return world()->is_fab(fab);
 }
 
 
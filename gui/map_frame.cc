@@ -413,7 +413,7 @@ void map_frame_t::update_factory_legend()
 		vector_tpl<const factory_desc_t*> factory_types;
 		// generate list of factory types
 		if(  filter_factory_list  ) {
-			FOR(slist_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
+			FOR(vector_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
 				if(  f->get_desc()->get_distribution_weight() > 0  ) {
 					factory_types.insert_unique_ordered(f->get_desc(), compare_factories);
 				}
@@ -1656,7 +1656,7 @@ void minimap_t::draw(scr_coord pos)
 	}
 
 	if(  mode & MAP_FACTORIES  ) {
-		FOR(  slist_tpl<fabrik_t*>,  const f,  world->get_fab_list()  ) {
+		FOR(  vector_tpl<fabrik_t*>,  const f,  world->get_fab_list()  ) {
 			// find top-left tile position
 			koord3d fab_tl_pos = f->get_pos();
 			if (grund_t *gr = world->lookup(f->get_pos())) {
@@ -226,6 +226,7 @@ void settings_routing_stats_t::init(settings_t const* const sets)
 	INIT_NUM( "max_choose_route_steps", sets->get_max_choose_route_steps(), 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "max_hops", sets->get_max_hops(), 100, 65000, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "max_transfers", sets->get_max_transfers(), 1, 100, gui_numberinput_t::AUTOLINEAR, false );
+	INIT_NUM( "transfer_table_memory", sets->get_transfer_table_memory(), 0, 4096, gui_numberinput_t::POWER2, false );
 	SEPERATOR
 	INIT_NUM( "way_straight", sets->way_count_straight, 1, 1000, gui_numberinput_t::AUTOLINEAR, false );
 	INIT_NUM( "way_curve", sets->way_count_curve, 1, 1000, gui_numberinput_t::AUTOLINEAR, false );
@@ -240,6 +241,7 @@ void settings_routing_stats_t::init(settings_t const* const sets)
 	INIT_NUM( "citycar_route_weight_crowded", sets->citycar_route_weight_crowded, 0, 1000, gui_numberinput_t::AUTOLINEAR, false );
 	INIT_NUM( "citycar_route_weight_vacant", sets->citycar_route_weight_vacant, 0, 1000, gui_numberinput_t::AUTOLINEAR, false );
 	INIT_NUM( "citycar_route_weight_speed", sets->citycar_route_weight_speed, -100, 100, gui_numberinput_t::AUTOLINEAR, false );
+	INIT_NUM( "citycar_detail_distance", sets->citycar_detail_distance, 0, 1000, gui_numberinput_t::AUTOLINEAR, false );
 	SEPERATOR
 	INIT_NUM( "routecost_wait", sets->routecost_wait, 1, 250, 1, false );
 	INIT_NUM( "routecost_halt", sets->routecost_halt, 1, 250, 1, false );
@@ -264,6 +266,7 @@ void settings_routing_stats_t::read(settings_t* const sets)
 	READ_NUM_VALUE( sets->max_choose_route_steps );
 	READ_NUM_VALUE( sets->max_hops );
 	READ_NUM_VALUE( sets->max_transfers );
+	READ_NUM_VALUE( sets->transfer_table_memory );
 	// routing on ways
 	READ_NUM_VALUE( sets->way_count_straight );
 	READ_NUM_VALUE( sets->way_count_curve );
@@ -278,6 +281,7 @@ void settings_routing_stats_t::read(settings_t* const sets)
 	READ_NUM_VALUE( sets->citycar_route_weight_crowded );
 	READ_NUM_VALUE( sets->citycar_route_weight_vacant );
 	READ_NUM_VALUE( sets->citycar_route_weight_speed );
+	READ_NUM_VALUE( sets->citycar_detail_distance );
 	
 	READ_NUM_VALUE( sets->routecost_wait );
 	READ_NUM_VALUE( sets->routecost_halt );
@@ -12,6 +12,7 @@
 #include "../simtypes.h"
 #include "../simconst.h"
 #include "../display/scr_coord.h"
+#include "../tpl/quickstone_tpl.h"
 
 
 /*
@@ -109,12 +110,12 @@ enum magic_numbers {
 	magic_soundfont, // only with USE_FLUIDSYNTH_MIDI
 	magic_edit_groundobj,
 
-	// magic numbers with big jumps between them
+	// magic numbers with big jumps between them, one for each handle index
 	magic_convoi_info,
-	magic_UNUSED_convoi_detail = magic_convoi_info          + 0x10000, // unused range
-	magic_halt_info            = magic_UNUSED_convoi_detail + 0x10000,
-	magic_UNUSED_halt_detail   = magic_halt_info            + 0x10000, // unused range
-	magic_toolbar              = magic_UNUSED_halt_detail   + 0x10000,
+	magic_UNUSED_convoi_detail = magic_convoi_info          + QUICKSTONE_MAX_ID+1, // unused range
+	magic_halt_info            = magic_UNUSED_convoi_detail + QUICKSTONE_MAX_ID+1,
+	magic_UNUSED_halt_detail   = magic_halt_info            + QUICKSTONE_MAX_ID+1, // unused range
+	magic_toolbar              = magic_UNUSED_halt_detail   + QUICKSTONE_MAX_ID+1,
 	magic_script_error         = magic_toolbar              + 0x100,
 	magic_haltlist_filter,
 	magic_depot, // only used to load/save
@@ -51,6 +51,13 @@ public:
 
 	// return the cost of a single step upwards
 	virtual uint32 get_cost_upslope() const { return 0; }
+
+	/**
+	 * Everything else than the ways the route search depends on (like owner or electrification),
+	 * to reuse the results of route_t::calc_route().
+	 * @return false if the searches of this driver must not be cached
+	 */
+	virtual bool get_route_cache_id(uint64 &) const { return false; }
 };
 
 #endif
@@ -26,6 +26,15 @@ public:
 	 */
 	virtual sync_result sync_step(uint32 delta_t) = 0;
 
+	/**
+	 * Does the sync_step(), if it only changes this object itself (like a
+	 * vehicle which stays on its tile). These steps run concurrently for
+	 * many objects, so nothing else must be written.
+	 * @return false if sync_step() must be called afterwards; parts of the
+	 * step, which only affect this object, may be already done then.
+	 */
+	virtual bool sync_step_local(uint32 /*delta_t*/, sync_result &/*result*/) { return false; }
+
 	virtual ~sync_steppable() {}
 };
 
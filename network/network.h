@@ -68,7 +68,8 @@
 
 
 // version of network protocol code
-#define NETWORK_VERSION (1)
+// 2: checklists with 32 bit handle entries
+#define NETWORK_VERSION (2)
 
 class network_command_t;
 class gameinfo_t;
@@ -139,6 +139,7 @@ public:
 	 * Count-down to replace construction site image by regular image.
 	 */
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE { result = sync_step(delta_t); return true; }
 
 	/**
 	 * @return Den level (die Ausbaustufe) des Gebaudes
@@ -252,6 +252,7 @@ public:
 	 * Gives players a visual indication of a power network with insufficient generation.
 	 */
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE { result = sync_step(delta_t); return true; }
 
 	const char *get_name() const OVERRIDE {return "Abspanntransformator";}
 
@@ -110,6 +110,7 @@ public:
 
 	// changes the state of a traffic light
 	sync_result sync_step(uint32) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE { result = sync_step(delta_t); return true; }
 
 	// change the phases of the traffic lights
 	uint8 get_ticks_ns() const { return ticks_ns; }
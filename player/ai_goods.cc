@@ -797,7 +797,7 @@ void ai_goods_t::step()
 			if(root==NULL) {
 				// find a tree root to complete
 				weighted_vector_tpl<fabrik_t *> start_fabs(20);
-				FOR(  slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()  ) {
+				FOR(  vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()  ) {
 					// consumer and not completely overcrowded
 					if(  fab->get_desc()->is_consumer_only()  &&  fab->get_status() != fabrik_t::STATUS_BAD  ) {
 						int missing = get_factory_tree_missing_count( fab );
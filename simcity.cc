@@ -62,6 +62,23 @@ static sint64 const CITYGROWTH_PER_CITIZEN = 1ll << 32; // Q31.32 fractional for
 
 karte_ptr_t stadt_t::welt; // one is enough ...
 
+struct stadt_t::pax_request_t
+{
+	stadt_t *city;
+	stadt_t *dest_city;
+	fabrik_t *factory; // target factory or NULL
+	koord origin_pos;
+	ware_t pax;
+	ware_t return_pax;
+	uint32 start_halts; // index of the first start halt in pax_start_halts
+	uint16 start_halt_count;
+	pax_return_type will_return;
+	int route_result;
+};
+
+vector_tpl<stadt_t::pax_request_t> stadt_t::pax_requests;
+vector_tpl<halthandle_t> stadt_t::pax_start_halts;
+
 
 /********************************* From here on cityrules stuff *****************************************/
 
@@ -118,12 +135,74 @@ public:
 	}
 };
 
+/**
+ * Properties of a tile tested by the rules
+ */
+enum {
+	RULE_TILE_ON_MAP     = 1 << 0,
+	RULE_TILE_ROAD       = 1 << 1,
+	RULE_TILE_FOUNDATION = 1 << 2,
+	RULE_TILE_HOUSE      = 1 << 3,
+	RULE_TILE_NATURE     = 1 << 4,
+	RULE_TILE_WAY_SLOPE  = 1 << 5,
+	RULE_TILE_HALT       = 1 << 6
+};
+
+/**
+ * A rule entry as test of the properties of a tile: (tiles[tile] & mask) == value
+ */
+struct rule_test_t {
+	uint8 tile;
+	uint8 mask;
+	uint8 value;
+};
+
 class rule_t {
 public:
 	sint16  chance;
 	vector_tpl<rule_entry_t> rule;
+
+	/// the entries as tests, for rotation 0, 90, 180 and 270
+	vector_tpl<rule_test_t> tests[4];
+
 	rule_t(uint32 count=0) : chance(0), rule(count) {}
 
+	/// converts the entries into tests
+	void compile()
+	{
+		for(  int rotation = 0;  rotation < 4;  rotation++  ) {
+			tests[rotation].clear();
+			FOR(vector_tpl<rule_entry_t>, const& r, rule) {
+				uint8 x,y;
+				switch (rotation) {
+					default:
+					case 0: x=r.x; y=r.y; break;
+					case 1: x=r.y; y=6-r.x; break;
+					case 2: x=6-r.x; y=6-r.y; break;
+					case 3: x=6-r.y; y=r.x; break;
+				}
+				rule_test_t test;
+				test.tile = x + y*7;
+				// outside of the map => cannot apply this rule
+				test.mask = RULE_TILE_ON_MAP;
+				test.value = RULE_TILE_ON_MAP;
+				switch (r.flag) {
+					case 's': test.mask |= RULE_TILE_ROAD;       test.value |= RULE_TILE_ROAD;      break;
+					case 'S': test.mask |= RULE_TILE_ROAD;                                          break;
+					case 'h': test.mask |= RULE_TILE_HOUSE;      test.value |= RULE_TILE_HOUSE;     break;
+					case 'H': test.mask |= RULE_TILE_FOUNDATION;                                    break;
+					case 'n': test.mask |= RULE_TILE_NATURE;     test.value |= RULE_TILE_NATURE;    break;
+					case 'U': test.mask |= RULE_TILE_WAY_SLOPE;  test.value |= RULE_TILE_WAY_SLOPE; break;
+					case 'u': test.mask |= RULE_TILE_WAY_SLOPE;                                     break;
+					case 't': test.mask |= RULE_TILE_HALT;       test.value |= RULE_TILE_HALT;      break;
+					case 'T': test.mask |= RULE_TILE_HALT;                                          break;
+					default: ;
+				}
+				tests[rotation].append(test);
+			}
+		}
+	}
+
 	void rdwr(loadsave_t* file)
 	{
 		file->rdwr_short(chance);
@@ -148,6 +227,21 @@ static vector_tpl<rule_t *> house_rules;
 // and road rules
 static vector_tpl<rule_t *> road_rules;
 
+
+/**
+ * Prepares the rules for evaluation, to be called after they changed
+ */
+static void compile_rules()
+{
+	FOR(vector_tpl<rule_t *>, const r, road_rules) {
+		r->compile();
+	}
+	FOR(vector_tpl<rule_t *>, const r, house_rules) {
+		r->compile();
+	}
+}
+
+
 /**
  * Symbols in rules:
  * S = not a road
@@ -165,72 +259,80 @@ static vector_tpl<rule_t *> road_rules;
 // here '.' is ignored, since it will not be tested anyway
 static char const* const allowed_chars_in_rule = "SsnHhTtUu";
 
+
 /**
- * @param pos position to check
- * @param regel the rule to evaluate
- * @return true on match, false otherwise
+ * @ref stadt_t::get_rule_tile
  */
-bool stadt_t::bewerte_loc(const koord pos, const rule_t &regel, int rotation)
+struct stadt_t::rule_tiles_t
 {
-	//printf("Test for (%s) in rotation %d\n", pos.get_str(), rotation);
-	koord k;
+	koord pos;
+	uint8 known[49]; // properties already evaluated
+	uint8 flags[49];
 
-	FOR(vector_tpl<rule_entry_t>, const& r, regel.rule) {
-		uint8 x,y;
-		switch (rotation) {
-			default:
-			case   0: x=r.x; y=r.y; break;
-			case  90: x=r.y; y=6-r.x; break;
-			case 180: x=6-r.x; y=6-r.y; break;
-			case 270: x=6-r.y; y=r.x; break;
-		}
+	rule_tiles_t(koord pos_) : pos(pos_)
+	{
+		MEMZERO(known);
+		MEMZERO(flags);
+	}
+};
+
+
+/**
+ * Each property is evaluated once per position, no matter how many rules
+ * and rotations test it, and only if a rule gets that far.
+ */
+uint8 stadt_t::get_rule_tile(rule_tiles_t &tiles, const uint8 tile, const uint8 mask)
+{
+	const uint8 missing = mask & ~tiles.known[tile];
+	if(  missing == 0  ) {
+		return tiles.flags[tile];
+	}
+
+	const grund_t* gr = welt->lookup_kartenboden(tiles.pos + koord(tile % 7 - 3, tile / 7 - 3));
+	if(  gr == NULL  ) {
+		// outside of the map => no rule applies
+		tiles.known[tile] = 0xFF;
+		tiles.flags[tile] = 0;
+		return 0;
+	}
+
+	uint8 flags = RULE_TILE_ON_MAP;
+	if(  (missing & RULE_TILE_ROAD)  &&  gr->hat_weg(road_wt)  ) {
+		flags |= RULE_TILE_ROAD;
+	}
+	if(  (missing & RULE_TILE_FOUNDATION)  &&  gr->get_typ() == grund_t::fundament  ) {
+		flags |= RULE_TILE_FOUNDATION;
+	}
+	if(  (missing & RULE_TILE_HOUSE)  &&  gr->get_typ() == grund_t::fundament  &&  gr->obj_bei(0)->get_typ() == obj_t::gebaeude  ) {
+		flags |= RULE_TILE_HOUSE;
+	}
+	if(  (missing & RULE_TILE_NATURE)  &&  gr->ist_natur()  &&  gr->kann_alle_obj_entfernen(NULL) == NULL  ) {
+		flags |= RULE_TILE_NATURE;
+	}
+	if(  (missing & RULE_TILE_WAY_SLOPE)  &&  slope_t::is_way(gr->get_grund_hang())  ) {
+		flags |= RULE_TILE_WAY_SLOPE;
+	}
+	if(  (missing & RULE_TILE_HALT)  &&  gr->is_halt()  ) {
+		flags |= RULE_TILE_HALT;
+	}
+	tiles.known[tile] |= missing | RULE_TILE_ON_MAP;
+	tiles.flags[tile] |= flags;
+	return tiles.flags[tile];
+}
 
-		const koord k(pos.x+x-3, pos.y+y-3);
-		const grund_t* gr = welt->lookup_kartenboden(k);
-		if (gr == NULL) {
-			// outside of the map => cannot apply this rule
+
+/**
+ * @param tiles properties of the tiles around the position to check
+ * @param regel the rule to evaluate
+ * @param rotation 0, 1, 2, 3 for 0, 90, 180, 270 degrees
+ * @return true on match, false otherwise
+ */
+bool stadt_t::bewerte_loc(rule_tiles_t &tiles, const rule_t &regel, int rotation)
+{
+	FOR(vector_tpl<rule_test_t>, const& test, regel.tests[rotation]) {
+		if(  (get_rule_tile(tiles, test.tile, test.mask) & test.mask) != test.value  ) {
 			return false;
 		}
-		switch (r.flag) {
-			case 's':
-				// road?
-				if (!gr->hat_weg(road_wt)) return false;
-				break;
-			case 'S':
-				// not road?
-				if (gr->hat_weg(road_wt)) return false;
-				break;
-			case 'h':
-				// is house
-				if (gr->get_typ() != grund_t::fundament  ||  gr->obj_bei(0)->get_typ()!=obj_t::gebaeude) return false;
-				break;
-			case 'H':
-				// no house
-				if (gr->get_typ() == grund_t::fundament) return false;
-				break;
-			case 'n':
-				// nature/empty
-				if (!gr->ist_natur() || gr->kann_alle_obj_entfernen(NULL) != NULL) return false;
-				break;
-			case 'U':
-				// unbuildable for road
-				if (!slope_t::is_way(gr->get_grund_hang())) return false;
-				break;
-			case 'u':
-				// road may be buildable
-				if (slope_t::is_way(gr->get_grund_hang())) return false;
-				break;
-			case 't':
-				// here is a stop/extension building
-				if (!gr->is_halt()) return false;
-				break;
-			case 'T':
-				// no stop
-				if (gr->is_halt()) return false;
-				break;
-			default: ;
-				// ignore
-		}
 	}
 	return true;
 }
@@ -240,31 +342,31 @@ bool stadt_t::bewerte_loc(const koord pos, const rule_t &regel, int rotation)
  * Check rule in all transformations at given position
  * @note but the rules should explicitly forbid building then?!?
  */
-sint32 stadt_t::bewerte_pos(const koord pos, const rule_t &regel)
+sint32 stadt_t::bewerte_pos(rule_tiles_t &tiles, const rule_t &regel)
 {
 	// will be called only a single time, so we can stop after a single match
-	if(bewerte_loc(pos, regel,   0) ||
-		 bewerte_loc(pos, regel,  90) ||
-		 bewerte_loc(pos, regel, 180) ||
-		 bewerte_loc(pos, regel, 270)) {
+	if(bewerte_loc(tiles, regel, 0) ||
+		 bewerte_loc(tiles, regel, 1) ||
+		 bewerte_loc(tiles, regel, 2) ||
+		 bewerte_loc(tiles, regel, 3)) {
 		return 1;
 	}
 	return 0;
 }
 
 
-void stadt_t::bewerte_strasse(koord k, sint32 rd, const rule_t &regel)
+void stadt_t::bewerte_strasse(koord k, sint32 rd, const rule_t &regel, rule_tiles_t &tiles)
 {
 	if (simrand(rd) == 0) {
-		best_strasse.check(k, bewerte_pos(k, regel));
+		best_strasse.check(k, bewerte_pos(tiles, regel));
 	}
 }
 
 
-void stadt_t::bewerte_haus(koord k, sint32 rd, const rule_t &regel)
+void stadt_t::bewerte_haus(koord k, sint32 rd, const rule_t &regel, rule_tiles_t &tiles)
 {
 	if (simrand(rd) == 0) {
-		best_haus.check(k, bewerte_pos(k, regel));
+		best_haus.check(k, bewerte_pos(tiles, regel));
 	}
 }
 
@@ -419,6 +521,7 @@ bool stadt_t::cityrules_init(const std::string &objfilename)
 			}
 		}
 	}
+	compile_rules();
 	return true;
 }
 
@@ -475,6 +578,9 @@ void stadt_t::cityrules_rdwr(loadsave_t *file)
 		}
 		road_rules[i]->rdwr(file);
 	}
+	if (file->is_loading()) {
+		compile_rules();
+	}
 }
 
 /**
@@ -1403,7 +1509,7 @@ void stadt_t::verbinde_fabriken()
 	assert( target_factories_pax.get_entries().empty() );
 	assert( target_factories_mail.get_entries().empty() );
 
-	FOR(slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
+	FOR(vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
 		const uint32 count = fab->get_target_cities().get_count();
 		if(  count < welt->get_settings().get_factory_worker_maximum_towns()  &&  koord_distance(fab->get_pos(), pos) < welt->get_settings().get_factory_worker_radius()  ) {
 			fab->add_target_city(this);
@@ -1694,11 +1800,18 @@ void stadt_t::new_month( bool recalc_destinations )
 				}
 
 				grund_t* gr = welt->lookup_kartenboden(k);
-				if(  gr != NULL  &&  gr->get_weg(road_wt)  &&  ribi_t::is_twoway(gr->get_weg_ribi_unmasked(road_wt))  &&  gr->find<private_car_t>() == NULL) {
-					private_car_t* vt = new private_car_t(gr, koord::invalid);
-					gr->obj_add(vt);
-					welt->sync.add(vt);
-					number_of_cars--;
+				if(  gr != NULL  &&  gr->get_weg(road_wt)  &&  ribi_t::is_twoway(gr->get_weg_ribi_unmasked(road_wt))  ) {
+					if(  !private_car_t::is_detailed(k)  ) {
+						// far from halts and convoys => only counted
+						((strasse_t *)gr->get_weg(road_wt))->book( 1, WAY_STAT_CONVOIS, gr->get_weg_ribi_unmasked(road_wt) );
+						number_of_cars--;
+					}
+					else if(  gr->find<private_car_t>() == NULL  ) {
+						private_car_t* vt = new private_car_t(gr, koord::invalid);
+						gr->obj_add(vt);
+						welt->sync.add(vt);
+						number_of_cars--;
+					}
 				}
 			}
 		}
@@ -1850,6 +1963,11 @@ void stadt_t::step_passagiere()
 
 	// only continue, if this is a good start halt
 	if(  !start_halts.empty()  ) {
+		const uint32 first_start_halt = pax_start_halts.get_count();
+		FOR(vector_tpl<halthandle_t>, const halt, start_halts) {
+			pax_start_halts.append( halt );
+		}
+
 		// Find passenger destination
 		for(  uint pax_routed=0, pax_left_to_do=0;  pax_routed < num_pax;  pax_routed += pax_left_to_do  ) {
 			// number of passengers that want to travel
@@ -1874,173 +1992,22 @@ void stadt_t::step_passagiere()
 				factory_entry->factory->book_stat(pax_left_to_do, ispass ? FAB_PAX_GENERATED : FAB_MAIL_GENERATED);
 			}
 
-			ware_t pax(wtyp);
-			pax.set_zielpos(dest_pos);
-			pax.menge = pax_left_to_do;
-			pax.to_factory = ( factory_entry ? 1 : 0 );
-
-			ware_t return_pax(wtyp);
-
-			// now, finally search a route; this consumes most of the time
-			int const route_result = haltestelle_t::search_route( &start_halts[0], start_halts.get_count(), welt->get_settings().is_no_routing_over_overcrowding(), pax, &return_pax);
-			halthandle_t start_halt = return_pax.get_ziel();
-			if(  route_result==haltestelle_t::ROUTE_OK  ) {
-				// so we have happy traveling passengers
-				start_halt->starte_mit_route(pax);
-				start_halt->add_pax_happy(pax.menge);
-
-				// people were transported so are logged
-				city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
-				city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
-
-				// destination logged
-				merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
-			}
-			else if(  route_result==haltestelle_t::ROUTE_WALK  ) {
-				if(  factory_entry  ) {
-					// workers and mail delivered instantly to factory
-					factory_entry->factory->liefere_an(wtyp, pax_left_to_do);
-				}
-
-				// log walked at stop
-				start_halt->add_pax_walked(pax_left_to_do);
-
-				// people who walk or deliver by hand logged as walking
-				city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
-				city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
-
-				// probably not a good idea to mark them as player only cares about remote traffic
-				//merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
-			}
-			else if(  route_result==haltestelle_t::ROUTE_OVERCROWDED  ) {
-				// overcrowded routes cause unhappiness to be logged
-
-				if(  start_halt.is_bound()  ) {
-					start_halt->add_pax_unhappy(pax_left_to_do);
-				}
-				else {
-					// all routes to goal are overcrowded -> register at first stop (closest)
-					FOR(vector_tpl<halthandle_t>, const s, start_halts) {
-						s->add_pax_unhappy(pax_left_to_do);
-						merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_ORANGE));
-						break;
-					}
-				}
-
-				// destination logged
-				merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_ORANGE));
-			}
-			else if (  route_result == haltestelle_t::NO_ROUTE  ) {
-				// since there is no route from any start halt -> register no route at first halts (closest)
-				FOR(vector_tpl<halthandle_t>, const s, start_halts) {
-					s->add_pax_no_route(pax_left_to_do);
-					break;
-				}
-				merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_DARK_ORANGE));
-#ifdef DESTINATION_CITYCARS
-				//citycars with destination
-				generate_private_cars( origin_pos, dest_pos );
-#endif
-			}
-
-			// return passenger traffic
-			if(  will_return != no_return  ) {
-				// compute return amount
-				uint32 pax_return = pax_left_to_do;
-
-				// apply return modifiers
-				if(  will_return != city_return  &&  wtyp == goods_manager_t::mail  ) {
-					// attractions and factories return more mail than they receive
-					pax_return *= MAIL_RETURN_MULTIPLIER_PRODUCERS;
-				}
-
-				// log potential return passengers at destination city
-				dest_city->city_history_year[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
-				dest_city->city_history_month[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
-
-				// factories generate return traffic
-				if (  factory_entry  ) {
-					factory_entry->factory->book_stat(pax_return, (ispass ? FAB_PAX_GENERATED : FAB_MAIL_GENERATED));
-				}
-
-				// route type specific logic
-				if(  route_result == haltestelle_t::ROUTE_OK  ) {
-					// send return packet
-					halthandle_t return_halt = pax.get_ziel();
-					if(  !return_halt->is_overcrowded(wtyp->get_index())  ) {
-						// stop can receive passengers
-
-						// register departed pax/mail at factory
-						if (factory_entry) {
-							factory_entry->factory->book_stat(pax_return, ispass ? FAB_PAX_DEPARTED : FAB_MAIL_DEPARTED);
-						}
-
-						// setup ware packet
-						return_pax.menge = pax_return;
-						return_pax.set_zielpos(origin_pos);
-						return_halt->starte_mit_route(return_pax);
-
-						// log departed at stop
-						return_halt->add_pax_happy(pax_return);
-
-						// log departed at destination city
-						dest_city->city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
-						dest_city->city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
-					}
-					else {
-						// stop is crowded
-						return_halt->add_pax_unhappy(pax_return);
-					}
-
-				}
-				else if(  route_result == haltestelle_t::ROUTE_WALK  ) {
-					// walking can produce return flow as a result of commuters to industry, monuments or stupidly big stops
-
-					// register departed pax/mail at factory
-					if (  factory_entry  ) {
-						factory_entry->factory->book_stat(pax_return, ispass ? FAB_PAX_DEPARTED : FAB_MAIL_DEPARTED);
-					}
-
-					// log walked at stop (source and destination stops are the same)
-					start_halt->add_pax_walked(pax_return);
-
-					// log people who walk or deliver by hand
-					dest_city->city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_return;
-					dest_city->city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_return;
-				}
-				else if(  route_result == haltestelle_t::ROUTE_OVERCROWDED  ) {
-					// overcrowded routes cause unhappiness to be logged
-
-					if (pax.get_ziel().is_bound()) {
-						pax.get_ziel()->add_pax_unhappy(pax_return);
-					}
-					else {
-						// the unhappy passengers will be added to the first stops near destination (might be none)
-						const planquadrat_t *const dest_plan = welt->access(dest_pos);
-						const halthandle_t *const dest_halt_list = dest_plan->get_haltlist();
-						for (uint h = 0; h < dest_plan->get_haltlist_count(); h++) {
-							halthandle_t halt = dest_halt_list[h];
-							if (halt->is_enabled(wtyp)) {
-								halt->add_pax_unhappy(pax_return);
-								break;
-							}
-						}
-					}
-				}
-				else if (route_result == haltestelle_t::NO_ROUTE) {
-					// passengers who cannot find a route will be added to the first stops near destination (might be none)
-					const planquadrat_t *const dest_plan = welt->access(dest_pos);
-					const halthandle_t *const dest_halt_list = dest_plan->get_haltlist();
-					for (uint h = 0; h < dest_plan->get_haltlist_count(); h++) {
-						halthandle_t halt = dest_halt_list[h];
-						if (halt->is_enabled(wtyp)) {
-							halt->add_pax_no_route(pax_return);
-							break;
-						}
-					}
-				}
-			}
-			INT_CHECK( "simcity 1579" );
+			// the route is searched for all packets of this step at once, see route_pax_requests()
+			pax_request_t request;
+			request.city = this;
+			request.dest_city = dest_city;
+			request.factory = factory_entry ? factory_entry->factory : NULL;
+			request.origin_pos = origin_pos;
+			request.pax = ware_t(wtyp);
+			request.pax.set_zielpos(dest_pos);
+			request.pax.menge = pax_left_to_do;
+			request.pax.to_factory = ( factory_entry ? 1 : 0 );
+			request.return_pax = ware_t(wtyp);
+			request.start_halts = first_start_halt;
+			request.start_halt_count = start_halts.get_count();
+			request.will_return = will_return;
+			request.route_result = haltestelle_t::NO_ROUTE;
+			pax_requests.append( request );
 		}
 	}
 	else {
@@ -2125,6 +2092,208 @@ void stadt_t::step_passagiere()
 }
 
 
+uint32 stadt_t::get_pax_request_count()
+{
+	return pax_requests.get_count();
+}
+
+
+void stadt_t::route_pax_requests(uint32 index_min, uint32 index_max, bool own_memory)
+{
+	haltestelle_t::route_search_memory_t *memory = own_memory ? haltestelle_t::get_route_search_memory() : NULL;
+	const bool no_routing_over_overcrowding = welt->get_settings().is_no_routing_over_overcrowding();
+	for(  uint32 i = index_min;  i < index_max;  i++  ) {
+		pax_request_t &request = pax_requests[i];
+		request.route_result = haltestelle_t::search_route( &pax_start_halts[request.start_halts], request.start_halt_count, no_routing_over_overcrowding, request.pax, &request.return_pax, memory );
+	}
+	if(  memory  ) {
+		haltestelle_t::release_route_search_memory( memory );
+	}
+}
+
+
+void stadt_t::book_pax_requests()
+{
+	for(  uint32 i = 0;  i < pax_requests.get_count();  i++  ) {
+		pax_request_t &request = pax_requests[i];
+		request.city->book_pax_request( request );
+		INT_CHECK( "simcity 1579" );
+	}
+	pax_requests.clear();
+	pax_start_halts.clear();
+}
+
+
+void stadt_t::book_pax_request(pax_request_t &request)
+{
+	ware_t &pax = request.pax;
+	ware_t &return_pax = request.return_pax;
+	const goods_desc_t *const wtyp = pax.get_desc();
+	const bool ispass = wtyp == goods_manager_t::passengers;
+	const uint32 history_type = ispass ? HIST_BASE_PASS : HIST_BASE_MAIL;
+	const uint32 pax_left_to_do = pax.menge;
+	const koord origin_pos = request.origin_pos;
+	const koord dest_pos = pax.get_zielpos();
+	stadt_t *const dest_city = request.dest_city;
+	fabrik_t *const factory = request.factory;
+	const pax_return_type will_return = request.will_return;
+	halthandle_t const first_start_halt = pax_start_halts[request.start_halts];
+	int const route_result = request.route_result;
+
+	halthandle_t start_halt = return_pax.get_ziel();
+	if(  route_result==haltestelle_t::ROUTE_OK  ) {
+		// so we have happy traveling passengers
+		start_halt->starte_mit_route(pax);
+		start_halt->add_pax_happy(pax.menge);
+
+		// people were transported so are logged
+		city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
+		city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
+
+		// destination logged
+		merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
+	}
+	else if(  route_result==haltestelle_t::ROUTE_WALK  ) {
+		if(  factory  ) {
+			// workers and mail delivered instantly to factory
+			factory->liefere_an(wtyp, pax_left_to_do);
+		}
+
+		// log walked at stop
+		start_halt->add_pax_walked(pax_left_to_do);
+
+		// people who walk or deliver by hand logged as walking
+		city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
+		city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
+
+		// probably not a good idea to mark them as player only cares about remote traffic
+		//merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
+	}
+	else if(  route_result==haltestelle_t::ROUTE_OVERCROWDED  ) {
+		// overcrowded routes cause unhappiness to be logged
+
+		if(  start_halt.is_bound()  ) {
+			start_halt->add_pax_unhappy(pax_left_to_do);
+		}
+		else {
+			// all routes to goal are overcrowded -> register at first stop (closest)
+			first_start_halt->add_pax_unhappy(pax_left_to_do);
+			merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_ORANGE));
+		}
+
+		// destination logged
+		merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_ORANGE));
+	}
+	else if (  route_result == haltestelle_t::NO_ROUTE  ) {
+		// since there is no route from any start halt -> register no route at first halts (closest)
+		first_start_halt->add_pax_no_route(pax_left_to_do);
+		merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_DARK_ORANGE));
+#ifdef DESTINATION_CITYCARS
+		//citycars with destination
+		generate_private_cars( origin_pos, dest_pos );
+#endif
+	}
+
+	// return passenger traffic
+	if(  will_return != no_return  ) {
+		// compute return amount
+		uint32 pax_return = pax_left_to_do;
+
+		// apply return modifiers
+		if(  will_return != city_return  &&  wtyp == goods_manager_t::mail  ) {
+			// attractions and factories return more mail than they receive
+			pax_return *= MAIL_RETURN_MULTIPLIER_PRODUCERS;
+		}
+
+		// log potential return passengers at destination city
+		dest_city->city_history_year[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
+		dest_city->city_history_month[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
+
+		// factories generate return traffic
+		if (  factory  ) {
+			factory->book_stat(pax_return, (ispass ? FAB_PAX_GENERATED : FAB_MAIL_GENERATED));
+		}
+
+		// route type specific logic
+		if(  route_result == haltestelle_t::ROUTE_OK  ) {
+			// send return packet
+			halthandle_t return_halt = pax.get_ziel();
+			if(  !return_halt->is_overcrowded(wtyp->get_index())  ) {
+				// stop can receive passengers
+
+				// register departed pax/mail at factory
+				if (factory) {
+					factory->book_stat(pax_return, ispass ? FAB_PAX_DEPARTED : FAB_MAIL_DEPARTED);
+				}
+
+				// setup ware packet
+				return_pax.menge = pax_return;
+				return_pax.set_zielpos(origin_pos);
+				return_halt->starte_mit_route(return_pax);
+
+				// log departed at stop
+				return_halt->add_pax_happy(pax_return);
+
+				// log departed at destination city
+				dest_city->city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
+				dest_city->city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
+			}
+			else {
+				// stop is crowded
+				return_halt->add_pax_unhappy(pax_return);
+			}
+
+		}
+		else if(  route_result == haltestelle_t::ROUTE_WALK  ) {
+			// walking can produce return flow as a result of commuters to industry, monuments or stupidly big stops
+
+			// register departed pax/mail at factory
+			if (  factory  ) {
+				factory->book_stat(pax_return, ispass ? FAB_PAX_DEPARTED : FAB_MAIL_DEPARTED);
+			}
+
+			// log walked at stop (source and destination stops are the same)
+			start_halt->add_pax_walked(pax_return);
+
+			// log people who walk or deliver by hand
+			dest_city->city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_return;
+			dest_city->city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_return;
+		}
+		else if(  route_result == haltestelle_t::ROUTE_OVERCROWDED  ) {
+			// overcrowded routes cause unhappiness to be logged
+
+			if (pax.get_ziel().is_bound()) {
+				pax.get_ziel()->add_pax_unhappy(pax_return);
+			}
+			else {
+				// the unhappy passengers will be added to the first stops near destination (might be none)
+				const planquadrat_t *const dest_plan = welt->access(dest_pos);
+				const halthandle_t *const dest_halt_list = dest_plan->get_haltlist();
+				for (uint h = 0; h < dest_plan->get_haltlist_count(); h++) {
+					halthandle_t halt = dest_halt_list[h];
+					if (halt->is_enabled(wtyp)) {
+						halt->add_pax_unhappy(pax_return);
+						break;
+					}
+				}
+			}
+		}
+		else if (route_result == haltestelle_t::NO_ROUTE) {
+			// passengers who cannot find a route will be added to the first stops near destination (might be none)
+			const planquadrat_t *const dest_plan = welt->access(dest_pos);
+			const halthandle_t *const dest_halt_list = dest_plan->get_haltlist();
+			for (uint h = 0; h < dest_plan->get_haltlist_count(); h++) {
+				halthandle_t halt = dest_halt_list[h];
+				if (halt->is_enabled(wtyp)) {
+					halt->add_pax_no_route(pax_return);
+					break;
+				}
+			}
+		}
+	}
+}
+
+
 koord stadt_t::get_zufallspunkt() const
 {
 	if(!buildings.empty()) {
@@ -3407,6 +3576,14 @@ void stadt_t::generate_private_cars(koord pos, koord target)
 								gr->get_weg_ribi_unmasked(road_wt) == ribi_t::northsouth ||
 								gr->get_weg_ribi_unmasked(road_wt) == ribi_t::eastwest
 							)) {
+						if(  !private_car_t::is_detailed(k)  ) {
+							// far from halts and convoys => only counted
+							((strasse_t *)gr->get_weg(road_wt))->book( 1, WAY_STAT_CONVOIS, gr->get_weg_ribi_unmasked(road_wt) );
+							city_history_month[0][HIST_CITYCARS] ++;
+							city_history_year[0][HIST_CITYCARS] ++;
+							number_of_cars --;
+							return;
+						}
 						// already a car here => avoid congestion
 						if(gr->obj_bei(gr->get_top()-1)->is_moving()) {
 							continue;
@@ -3703,13 +3880,16 @@ void stadt_t::build()
 	// checks only make sense on empty ground
 	if(gr->ist_natur()) {
 
+		// properties of the tiles around k, shared by all rules
+		rule_tiles_t tiles(k);
+
 		// since only a single location is checked, we can stop after we have found a positive rule
 		best_strasse.reset(k);
 		const uint32 num_road_rules = road_rules.get_count();
 		uint32 offset = simrand(num_road_rules); // start with random rule
 		for (uint32 i = 0; i < num_road_rules  &&  !best_strasse.found(); i++) {
 			uint32 rule = ( i+offset ) % num_road_rules;
-			bewerte_strasse(k, 8 + road_rules[rule]->chance, *road_rules[rule]);
+			bewerte_strasse(k, 8 + road_rules[rule]->chance, *road_rules[rule], tiles);
 		}
 		// ok => then built road
 		if (best_strasse.found()) {
@@ -3726,7 +3906,7 @@ void stadt_t::build()
 		offset = simrand(num_house_rules); // start with random rule
 		for(  uint32 i = 0;  i < num_house_rules  &&  !best_haus.found();  i++  ) {
 			uint32 rule = ( i+offset ) % num_house_rules;
-			bewerte_haus(k, 8 + house_rules[rule]->chance, *house_rules[rule]);
+			bewerte_haus(k, 8 + house_rules[rule]->chance, *house_rules[rule], tiles);
 		}
 		// one rule applied?
 		if(  best_haus.found()  ) {
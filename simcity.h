@@ -9,6 +9,7 @@
 
 #include "obj/simobj.h"
 #include "obj/gebaeude.h"
+#include "halthandle_t.h"
 
 #include "tpl/vector_tpl.h"
 #include "tpl/weighted_vector_tpl.h"
@@ -121,6 +122,18 @@ public:
 	static void set_cluster_factor( uint32 factor ) { stadt_t::cluster_factor = factor; }
 	static uint32 get_cluster_factor() { return stadt_t::cluster_factor; }
 
+	/**
+	 * Passengers and mail are generated in two passes: step() chooses the destinations,
+	 * then the routes of all packets are searched (see karte_t::route_passengers())
+	 * and the packets are booked in the order they were generated.
+	 */
+	static uint32 get_pax_request_count();
+
+	/// searches the routes of the packets from @p index_min to @p index_max-1, with separate search memory if @p own_memory
+	static void route_pax_requests(uint32 index_min, uint32 index_max, bool own_memory);
+
+	static void book_pax_requests();
+
 private:
 	static karte_ptr_t welt;
 	player_t *owner;
@@ -335,6 +348,16 @@ private:
 	 */
 	void step_passagiere();
 
+	/// packet of passengers or mail generated by step_passagiere() waiting for its route
+	struct pax_request_t;
+
+	/// packets of the current step in order of generation and their start halts
+	static vector_tpl<pax_request_t> pax_requests;
+	static vector_tpl<halthandle_t> pax_start_halts;
+
+	/// books the routed packet at the halts and in the statistics
+	void book_pax_request(pax_request_t &request);
+
 	/**
 	 * ein Passagierziel in die Zielkarte eintragen
 	 */
@@ -380,20 +403,28 @@ protected:
 private:
 	void build();
 
+	/// properties of the tiles around a position tested by the rules, see get_rule_tile()
+	struct rule_tiles_t;
+
+	/**
+	 * @return the properties @p mask of tile @p tile around the position, evaluated on first use
+	 */
+	static uint8 get_rule_tile(rule_tiles_t &tiles, uint8 tile, uint8 mask);
+
 	/**
-	 * @param pos position to check
+	 * @param tiles properties of the tiles around the position to check
 	 * @param regel the rule to evaluate
 	 * @return true on match, false otherwise
 	 */
-	static bool bewerte_loc(koord pos, const rule_t &regel, int rotation);
+	static bool bewerte_loc(rule_tiles_t &tiles, const rule_t &regel, int rotation);
 
 	/**
 	 * Check rule in all transformations at given position
 	 */
-	static sint32 bewerte_pos(koord pos, const rule_t &regel);
+	static sint32 bewerte_pos(rule_tiles_t &tiles, const rule_t &regel);
 
-	void bewerte_strasse(koord pos, sint32 rd, const rule_t &regel);
-	void bewerte_haus(koord pos, sint32 rd, const rule_t &regel);
+	void bewerte_strasse(koord pos, sint32 rd, const rule_t &regel, rule_tiles_t &tiles);
+	void bewerte_haus(koord pos, sint32 rd, const rule_t &regel, rule_tiles_t &tiles);
 
 	/**
 	 * Updates city limits: tile at @p pos belongs to city.
@@ -152,6 +152,7 @@ void convoi_t::init(player_t *player)
 	akt_speed_soll = 0;            // target speed
 	akt_speed = 0;                 // current speed
 	sp_soll = 0;
+	drive_prepared = false;
 
 	next_stop_index = 65535;
 	next_coupling_index = route_t::INVALID_INDEX;
@@ -177,6 +178,8 @@ void convoi_t::init(player_t *player)
 	prev_tiles_overtaking = 0;
 	
 	longblock_signal_request.valid = false;
+	prepared_route.valid = false;
+	route_requested = false;
 	crossing_reservation_index.clear();
 	recalc_min_top_speed = true;
 
@@ -236,7 +239,7 @@ DBG_MESSAGE("convoi_t::~convoi_t()", "destroying %d, %p", self.get_id(), this);
 			destroy_win((ptrdiff_t)schedule);
 		}
 		if (!schedule->empty() && !line.is_bound()) {
-			welt->set_schedule_counter();
+			welt->set_schedule_counter( false );
 		}
 		delete schedule;
 	}
@@ -990,12 +993,18 @@ int convoi_t::get_vehicle_at_length(uint16 length)
 // moves all vehicles of a convoi
 sync_result convoi_t::sync_step(uint32 delta_t)
 {
-	// still have to wait before next action?
-	wait_lock -= delta_t;
-	if(wait_lock > 0) {
-		return SYNC_OK;
+	// only valid for this step and only while driving
+	const bool prepared = drive_prepared  &&  state==DRIVING;
+	drive_prepared = false;
+
+	if(  !prepared  ) {
+		// still have to wait before next action?
+		wait_lock -= delta_t;
+		if(wait_lock > 0) {
+			return SYNC_OK;
+		}
+		wait_lock = 0;
 	}
-	wait_lock = 0;
 
 	switch(state) {
 		case INITIAL:
@@ -1067,10 +1076,12 @@ sync_result convoi_t::sync_step(uint32 delta_t)
 
 		case DRIVING:
 			{
-				calc_acceleration(delta_t);
+				if(  !prepared  ) {
+					calc_acceleration(delta_t);
+					sp_soll += (akt_speed*delta_t*speed_magnification/100);
+				}
 
 				// now actually move the units
-				sp_soll += (akt_speed*delta_t*speed_magnification/100);
 				uint32 sp_hat = fahr[0]->do_drive(sp_soll);
 				// stop when depot reached ...
 				if(state==INITIAL) {
@@ -1128,6 +1139,78 @@ sync_result convoi_t::sync_step(uint32 delta_t)
 	return SYNC_OK;
 }
 
+bool convoi_t::sync_step_local(uint32 delta_t, sync_result &result)
+{
+	if(  wait_lock > (sint32)delta_t  ) {
+		wait_lock -= delta_t;
+		result = SYNC_OK;
+		return true;
+	}
+
+	switch(state) {
+		case INITIAL:
+		case LEAVING_DEPOT:
+			return false;
+
+		case DRIVING:
+			if(  coupling_convoi.is_bound()  ) {
+				// also changes the coupled convoys
+				return false;
+			}
+			wait_lock = 0;
+			calc_acceleration(delta_t);
+			sp_soll += (akt_speed*delta_t*speed_magnification/100);
+			drive_prepared = true;
+			if(  next_wolke+delta_t > 500  ||  fahr[0]->will_hop(sp_soll)  ) {
+				// smoke and next tiles are done by sync_step()
+				return false;
+			}
+			else {
+				// all vehicles move the distance of the first one
+				const uint32 sp_hat = (sp_soll >> YARDS_PER_VEHICLE_STEP_SHIFT) ? sp_soll & YARDS_VEHICLE_STEP_MASK : 0;
+				for(  uint8 i=1;  i<anz_vehikel;  i++  ) {
+					if(  fahr[i]->will_hop(sp_hat)  ) {
+						return false;
+					}
+				}
+				for(  uint8 i=0;  i<anz_vehikel;  i++  ) {
+					fahr[i]->do_drive(sp_hat);
+				}
+				sp_soll = (sp_soll-sp_hat) & 0x0FFF;
+				next_wolke += delta_t;
+				drive_prepared = false;
+			}
+			break;
+
+		case EDIT_SCHEDULE:
+		case ROUTING_1:
+		case DUMMY4:
+		case DUMMY5:
+		case NO_ROUTE:
+		case CAN_START:
+		case CAN_START_ONE_MONTH:
+		case CAN_START_TWO_MONTHS:
+		case ENTERING_DEPOT:
+		case COUPLED:
+		case COUPLED_LOADING:
+		case WAITING_FOR_LEAVING_DEPOT:
+		case LOADING:
+		case WAITING_FOR_CLEARANCE:
+		case WAITING_FOR_CLEARANCE_ONE_MONTH:
+		case WAITING_FOR_CLEARANCE_TWO_MONTHS:
+		case SELF_DESTRUCT:
+			// nothing to do in sync_step()
+			wait_lock = 0;
+			break;
+
+		default:
+			return false;
+	}
+	result = SYNC_OK;
+	return true;
+}
+
+
 // a helper function for convoi_t::drive_to()
 bool was_coupling_with_heading(convoi_t* cnv) {
 	const vehicle_t* v = cnv->front();
@@ -1149,6 +1232,41 @@ bool was_coupling_with_heading(convoi_t* cnv) {
 	return false;
 }
 
+void convoi_t::get_drive_to_ends(koord3d &start, koord3d &ziel)
+{
+	// after coupling with heading convoy, we have to use tail pos of coupling convoy to avoid jumping.
+	if(  was_coupling_with_heading(this)  ) {
+		// use tail of coupling convoy
+		convoihandle_t c = get_coupling_convoi();
+		while(  c.is_bound()  ) {
+			if(  !c->get_coupling_convoi().is_bound()  ) {
+				start = c->back()->get_pos();
+			}
+			c = c->get_coupling_convoi();
+		}
+	} else {
+		start = front()->get_pos();
+	}
+	ziel = schedule->get_current_entry().pos;
+
+	// avoid stopping mid-halt
+	if(  start==ziel  ) {
+		halthandle_t halt = haltestelle_t::get_halt(ziel,get_owner());
+		if(  halt.is_bound()  &&  route.is_contained(start)  ) {
+			for(  uint32 i=route.index_of(start);  i<route.get_count();  i++  ) {
+				grund_t *gr = welt->lookup(route.at(i));
+				if(  gr  && gr->get_halt()==halt  ) {
+					ziel = gr->get_pos();
+				}
+				else {
+					break;
+				}
+			}
+		}
+	}
+}
+
+
 /**
  * Berechne route von Start- zu Zielkoordinate
  */
@@ -1179,37 +1297,8 @@ bool convoi_t::drive_to()
 			r->unreserve_all_tiles();
 		}
 
-		koord3d start;
-		// after coupling with heading convoy, we have to use tail pos of coupling convoy to avoid jumping.
-		if(  was_coupling_with_heading(this)  ) {
-			// use tail of coupling convoy
-			convoihandle_t c = get_coupling_convoi();
-			while(  c.is_bound()  ) {
-				if(  !c->get_coupling_convoi().is_bound()  ) {
-					start = c->back()->get_pos();
-				}
-				c = c->get_coupling_convoi();
-			}
-		} else {
-			start = front()->get_pos();
-		}
-		koord3d ziel = schedule->get_current_entry().pos;
-
-		// avoid stopping mid-halt
-		if(  start==ziel  ) {
-			halthandle_t halt = haltestelle_t::get_halt(ziel,get_owner());
-			if(  halt.is_bound()  &&  route.is_contained(start)  ) {
-				for(  uint32 i=route.index_of(start);  i<route.get_count();  i++  ) {
-					grund_t *gr = welt->lookup(route.at(i));
-					if(  gr  && gr->get_halt()==halt  ) {
-						ziel = gr->get_pos();
-					}
-					else {
-						break;
-					}
-				}
-			}
-		}
+		koord3d start, ziel;
+		get_drive_to_ends( start, ziel );
 
 		if(  !fahr[0]->calc_route( start, ziel, speed_to_kmh(min_top_speed), &route )  ) {
 			if(  state != NO_ROUTE  ) {
@@ -1336,9 +1425,48 @@ void convoi_t::suche_neue_route()
 /**
  * Asynchrne step methode des Convois
  */
+void convoi_t::prepare_step(route_t::search_context_t &ctx)
+{
+	prepared_route.valid = false;
+
+	// only states where step() will search a route
+	if(  wait_lock > 0  ||  (state != ROUTING_1  &&  state != NO_ROUTE)  ||  line_update_pending.is_bound()  ||  route_requested  ) {
+		return;
+	}
+	// aircraft search their routes in several parts, see air_vehicle_t::calc_route()
+	if(  anz_vehikel == 0  ||  schedule->empty()  ||  fahr[0]->get_waytype() == air_wt  ) {
+		return;
+	}
+	if(  state == ROUTING_1  &&  fahr[0]->get_pos() == schedule->get_current_entry().pos  ) {
+		// already there
+		return;
+	}
+
+	get_drive_to_ends( prepared_route.start, prepared_route.ziel );
+	prepared_route.max_speed = speed_to_kmh(min_top_speed);
+	prepared_route.result = prepared_route.route.calc_route( welt, prepared_route.start, prepared_route.ziel, fahr[0], prepared_route.max_speed, fahr[0]->get_route_halt_length(), &ctx );
+	prepared_route.valid = true;
+}
+
+
+bool convoi_t::take_prepared_route(koord3d start, koord3d ziel, sint32 max_speed, route_t *r, route_t::route_result_t &result)
+{
+	if(  !prepared_route.valid  ||  prepared_route.start != start  ||  prepared_route.ziel != ziel  ||  prepared_route.max_speed != max_speed  ) {
+		return false;
+	}
+	r->swap( prepared_route.route );
+	route_t old_route;
+	prepared_route.route.swap( old_route ); // free memory of the replaced route
+	prepared_route.valid = false;
+	result = prepared_route.result;
+	return true;
+}
+
+
 void convoi_t::step()
 {
 	if(  wait_lock > 0  ) {
+		prepared_route.valid = false;
 		return;
 	}
 
@@ -1411,6 +1539,10 @@ void convoi_t::step()
 						// go to next
 						state = ROUTING_1;
 					}
+					if(  state == ROUTING_1  ) {
+						// many convois may change their schedule at once => search the routes spread over the next steps
+						welt->request_convoi_route( self );
+					}
 					
 					// release departure slot if needed.
 					if(  h.is_bound()  &&  scheduled_departure_time>0  ) {
@@ -1436,6 +1568,10 @@ void convoi_t::step()
 						ziel_erreicht();
 						break;
 					}
+					if(  route_requested  ) {
+						// not yet our turn, see karte_t::serve_convoi_route_requests()
+						break;
+					}
 					// now calculate a new route
 					drive_to();
 					// finally, was there a record last time?
@@ -1593,6 +1729,9 @@ void convoi_t::step()
 			break;
 		default: ;
 	}
+
+	// not used in this step => outdated in the next one
+	prepared_route.valid = false;
 }
 
 
@@ -1717,6 +1856,7 @@ void convoi_t::betrete_depot(depot_t *dep, bool is_loading)
 
 	maxspeed_average_count = 0;
 	state = INITIAL;
+	drive_prepared = false;
 	dep->convoi_arrived(self, !is_loading  &&  get_schedule());
 }
 
@@ -1779,7 +1919,9 @@ void convoi_t::start()
 			line->recalc_catg_index();
 		}
 		else {
-			welt->set_schedule_counter();
+			// might serve other goods now
+			haltestelle_t::set_connections_dirty( schedule, get_owner() );
+			welt->set_schedule_counter( false );
 		}
 		wait_lock = 0;
 
@@ -2124,7 +2266,7 @@ bool convoi_t::set_schedule(schedule_t * f)
 			// if line is unset or schedule is changed
 			// -> register stops from new schedule
 			register_stops();
-			welt->set_schedule_counter(); // must trigger refresh
+			welt->set_schedule_counter( false ); // must trigger refresh, the stops are marked by register_stops()
 		}
 	}
 
@@ -2496,8 +2638,8 @@ void convoi_t::vorfahren()
 void convoi_t::rdwr_convoihandle_t(loadsave_t *file, convoihandle_t &cnv)
 {
 	if(  file->is_version_atleast(112, 3)  ) {
-		uint16 id = (file->is_saving()  &&  cnv.is_bound()) ? cnv.get_id() : 0;
-		file->rdwr_short( id );
+		uint32 id = (file->is_saving()  &&  cnv.is_bound()) ? cnv.get_id() : 0;
+		file->rdwr_handle_id( id );
 		if (file->is_loading()) {
 			cnv.set_id( id );
 		}
@@ -2532,14 +2674,14 @@ void convoi_t::rdwr(loadsave_t *file)
 			self = convoihandle_t( this );
 		}
 		else {
-			uint16 id;
-			file->rdwr_short( id );
-			self = convoihandle_t( this, id );
+			uint32 id;
+			file->rdwr_handle_id( id );
+			self = convoihandle_t( this, (quickstone_id_t)id );
 		}
 	}
 	else if(  file->is_version_atleast(112, 3)  ) {
-		uint16 id = self.get_id();
-		file->rdwr_short( id );
+		uint32 id = self.get_id();
+		file->rdwr_handle_id( id );
 	}
 
 	dummy = anz_vehikel;
@@ -3139,7 +3281,7 @@ void convoi_t::get_freight_info(cbuffer_t & buf)
 
 void convoi_t::open_schedule_window( bool show )
 {
-	DBG_MESSAGE("convoi_t::open_schedule_window()","Id = %hu, State = %d, Lock = %d", self.get_id(), (int)state, wait_lock);
+	DBG_MESSAGE("convoi_t::open_schedule_window()","Id = %u, State = %d, Lock = %d", (uint32)self.get_id(), (int)state, wait_lock);
 
 	// manipulation of schedule not allowed while:
 	// - just starting
@@ -3454,6 +3596,8 @@ station_tile_search_ready: ;
 		loading_needed &= (schedule->get_current_entry().waiting_time_shift > 0  &&  welt->get_ticks() - arrived_time >= welt->ticks_per_world_month / schedule->get_current_entry().waiting_time_shift);
 	}
 
+	// first unload all vehicles, so the halt storage does not change while loading
+	vector_tpl<uint16> unloaded(vehicles_loading);
 	for(unsigned i=0; i<vehicles_loading; i++) {
 		vehicle_t* v = fahr[i];
 
@@ -3466,13 +3610,20 @@ station_tile_search_ready: ;
 			v->last_stop_pos = v->get_pos();
 		}
 
-		uint16 amount = v->unload_cargo(halt, next_depot  );
+		unloaded.append( v->unload_cargo(halt, next_depot  ) );
+	}
+
+	// then load all vehicles from the same plan of the waiting goods
+	loading_plan_t plan;
+	for(unsigned i=0; i<vehicles_loading; i++) {
+		vehicle_t* v = fahr[i];
+		uint16 amount = unloaded[i];
 
 		if(  loading_needed  &&  v->get_total_cargo() < v->get_cargo_max()  ) {
 			// load if: unloaded something (might go back) or previous non-filled car requested different cargo type
 			if (amount>0  ||  cargo_type_prev==NULL  ||  !cargo_type_prev->is_interchangeable(v->get_cargo_type())) {
 				// load
-				amount += v->load_cargo(halt, destination_halts);
+				amount += v->load_cargo(halt, destination_halts, plan);
 			}
 			if (v->get_total_cargo() < v->get_cargo_max()) {
 				// not full
@@ -3495,6 +3646,9 @@ station_tile_search_ready: ;
 			time = max( time, (v->get_cargo_max()*2*v->get_desc()->get_loading_time()) / max(v->get_cargo_max(), 1) );
 		}
 	}
+	if(  halt.is_bound()  ) {
+		halt->end_loading();
+	}
 	freight_info_resort |= changed_loading_level;
 	if(  changed_loading_level  ) {
 		halt->recalc_status();
@@ -3888,7 +4042,7 @@ void convoi_t::set_line(linehandle_t org_line)
 		unregister_stops();
 		// must trigger refresh if old schedule was not empty
 		if (schedule  &&  !schedule->empty()) {
-			welt->set_schedule_counter();
+			welt->set_schedule_counter( false );
 		}
 	}
 	line_update_pending = org_line;
@@ -149,6 +149,7 @@ private:
 	sint32 min_top_speed;
 
 	sint32 sp_soll;           // steps to go
+	bool drive_prepared;      // sync_step_local() did already accelerate, sync_step() just moves
 	sint32 max_record_speed; // current convois fastest speed ever
 
 	// things for the world record
@@ -337,6 +338,26 @@ private:
 	} longblock_signal_request_t;
 	longblock_signal_request_t longblock_signal_request;
 
+	/**
+	 * Route searched in advance by prepare_step(), used by the next route search
+	 * of the leading vehicle if start, target and speed are the same.
+	 */
+	typedef struct {
+		bool valid;
+		koord3d start;
+		koord3d ziel;
+		sint32 max_speed;
+		route_t::route_result_t result;
+		route_t route;
+	} prepared_route_t;
+	prepared_route_t prepared_route;
+
+	/**
+	 * True while waiting in karte_t::request_convoi_route() for the route search after a schedule change.
+	 * Not saved, the queue is empty after loading.
+	 */
+	bool route_requested;
+
 	/**
 	 * struct holds new financial history for convoi
 	 */
@@ -366,6 +387,11 @@ private:
 	*/
 	bool drive_to();
 
+	/**
+	 * Where drive_to() searches the route from and to.
+	 */
+	void get_drive_to_ends(koord3d &start, koord3d &ziel);
+
 	/**
 	* Setup vehicles for moving in same direction than before
 	* if the direction is the same as before
@@ -486,7 +512,7 @@ public:
 	/**
 	 * set state: only use by tool_t::tool_change_convoi_t
 	 */
-	void set_state( uint16 new_state ) { assert(new_state<MAX_STATES); state = (states)new_state; }
+	void set_state( uint16 new_state ) { assert(new_state<MAX_STATES); if(  state!=new_state  ) { drive_prepared = false; } state = (states)new_state; }
 
 	/**
 	* get state
@@ -645,11 +671,29 @@ public:
 	 */
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
 
+	/**
+	 * Waiting and accelerating only change the convoi itself, driving too
+	 * as long as no vehicle leaves its tile.
+	 */
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE;
+
 	/**
 	 * All things like route search or loading, that may take a little
 	 */
 	void step();
 
+	/**
+	 * Searches the route step() will need in advance, without changing anything else.
+	 * Can run in parallel for different convois, each thread with its own @p ctx.
+	 */
+	void prepare_step(route_t::search_context_t &ctx);
+
+	/**
+	 * If the route from @p start to @p ziel was already searched by prepare_step(),
+	 * moves it to @p r and returns true.
+	 */
+	bool take_prepared_route(koord3d start, koord3d ziel, sint32 max_speed, route_t *r, route_t::route_result_t &result);
+
 	/**
 	* sets a new convoi in route
 	*/
@@ -662,6 +706,9 @@ public:
 	* force calculate a new route
 	*/
 	void suche_neue_route();
+
+	bool is_route_requested() const { return route_requested; }
+	void set_route_requested(bool yes) { route_requested = yes; }
 	
 	/**
 	 * remove all track reservations (trains only)
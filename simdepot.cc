@@ -54,6 +54,7 @@ depot_t::depot_t(koord3d pos, player_t *player, const building_tile_desc_t *t) :
 	gebaeude_t(pos, player, t)
 {
 	all_depots.append(this);
+	weg_t::increment_generation(); // only own depots can be entered
 	selected_filter = VEHICLE_FILTER_RELEVANT;
 	selected_sort_by = SORT_BY_DEFAULT;
 	last_selected_line = linehandle_t();
@@ -66,6 +67,7 @@ depot_t::~depot_t()
 {
 	destroy_win((ptrdiff_t)this);
 	all_depots.remove(this);
+	weg_t::increment_generation();
 }
 
 
@@ -120,7 +122,7 @@ void depot_t::call_depot_tool( char tool, convoihandle_t cnv, const char *extra)
 	// call depot tool
 	tool_t *tmp_tool = create_tool( TOOL_CHANGE_DEPOT | SIMPLE_TOOL );
 	cbuffer_t buf;
-	buf.printf( "%c,%s,%hu", tool, get_pos().get_str(), cnv.get_id() );
+	buf.printf( "%c,%s,%u", tool, get_pos().get_str(), (uint32)cnv.get_id() );
 	if(  extra  ) {
 		buf.append( "," );
 		buf.append( extra );
@@ -46,6 +46,10 @@
 
 #include "utils/simrandom.h"
 #include "utils/cbuffer_t.h"
+#include "tpl/inthashtable_tpl.h"
+#ifdef MULTI_THREAD
+#include "utils/simthread.h"
+#endif
 
 #include "gui/simwin.h"
 #include "display/simgraph.h"
@@ -107,40 +111,114 @@ sint32 work_from_production(sint64 prod, sint64 scaled){
 	return prod ? ((scaled << WORK_BITS) + prod - 1) / prod : 0;
 }
 
+vector_tpl<ware_production_t::stats_chunk_t *> ware_production_t::stats_chunks;
+vector_tpl<uint32> ware_production_t::free_stats_slots;
+
+
+ware_production_t::ware_production_t() : type(NULL), menge(0), max(0),
+	max_transit(0), placing_orders(false), index_offset(0)
+{
+#ifdef TRANSIT_DISTANCE
+	count_suppliers = 0;
+#endif
+	alloc_stats();
+	init_stats();
+}
+
+
+ware_production_t::ware_production_t(const ware_production_t &other)
+{
+	alloc_stats();
+	*this = other;
+}
+
+
+ware_production_t::~ware_production_t()
+{
+	free_stats_slots.append( stats_slot );
+}
+
+
+ware_production_t &ware_production_t::operator=(const ware_production_t &other)
+{
+	if(  this != &other  ) {
+		copy_from( other );
+		for(  int m=0;  m<MAX_MONTH;  ++m  ) {
+			for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
+				stat( m, s ) = other.stat( m, s );
+			}
+		}
+		weighted_sum_storage() = other.weighted_sum_storage();
+	}
+	return *this;
+}
+
+
+void ware_production_t::copy_from(const ware_production_t &other)
+{
+	type = other.type;
+	menge = other.menge;
+	max = other.max;
+	max_transit = other.max_transit;
+	placing_orders = other.placing_orders;
+#ifdef TRANSIT_DISTANCE
+	count_suppliers = other.count_suppliers;
+#endif
+	index_offset = other.index_offset;
+}
+
+
+void ware_production_t::alloc_stats()
+{
+	if(  free_stats_slots.empty()  ) {
+		// all chunks are in use
+		const uint32 first = stats_chunks.get_count() * STATS_CHUNK_SLOTS;
+		stats_chunks.append( new stats_chunk_t() );
+		for(  uint32 i = STATS_CHUNK_SLOTS;  i-- > 0;  ) {
+			free_stats_slots.append( first + i );
+		}
+	}
+	stats_slot = free_stats_slots.pop_back();
+	chunk = stats_chunks[ stats_slot / STATS_CHUNK_SLOTS ];
+}
+
+
 void ware_production_t::init_stats()
 {
 	for(  int m=0;  m<MAX_MONTH;  ++m  ) {
 		for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
-			statistics[m][s] = 0;
+			stat( m, s ) = 0;
 		}
 	}
-	weighted_sum_storage = 0;
+	weighted_sum_storage() = 0;
 }
 
 
-void ware_production_t::roll_stats(uint32 factor, sint64 aggregate_weight)
+void ware_production_t::finish_month(uint32 factor, sint64 aggregate_weight)
 {
 	// calculate weighted average storage first
 	if(  aggregate_weight>0  ) {
-		set_stat( weighted_sum_storage / aggregate_weight, FAB_GOODS_STORAGE );
+		set_stat( weighted_sum_storage() / aggregate_weight, FAB_GOODS_STORAGE );
 	}
+	// restore current storage level after rolling
+	chunk->next_storage[ stats_slot & (STATS_CHUNK_SLOTS-1) ] = (sint64)menge * (sint64)factor;
+}
 
-	for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
-		for(  int m=MAX_MONTH-1;  m>0;  --m  ) {
-			statistics[m][s] = statistics[m-1][s];
-		}
-		if(  s==FAB_GOODS_TRANSIT  ) {
-			// keep the current amount in transit
-			statistics[0][s] = statistics[1][s];
-		}
-		else {
-			statistics[0][s] = 0;
+
+void ware_production_t::roll_all_stats()
+{
+	FOR(vector_tpl<stats_chunk_t *>, const c, stats_chunks) {
+		memmove( c->statistics[1], c->statistics[0], sizeof(c->statistics[0]) * (MAX_MONTH-1) );
+		for(  uint32 i = 0;  i < STATS_CHUNK_SLOTS;  i++  ) {
+			for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
+				// keep the current amount in transit
+				if(  s != FAB_GOODS_TRANSIT  ) {
+					c->statistics[0][i][s] = s==FAB_GOODS_STORAGE ? c->next_storage[i] : 0;
+				}
+			}
 		}
+		MEMZERO( c->weighted_sum_storage );
 	}
-	weighted_sum_storage = 0;
-
-	// restore current storage level
-	set_stat( (sint64)menge * (sint64)factor, FAB_GOODS_STORAGE );
 }
 
 
@@ -152,11 +230,15 @@ void ware_production_t::rdwr(loadsave_t *file)
 
 	// we use a temporary variable to save/load old data correctly
 	sint64 statistics_buf[MAX_MONTH][MAX_FAB_GOODS_STAT];
-	memcpy( statistics_buf, statistics, sizeof(statistics_buf) );
+	for(  int m=0;  m<MAX_MONTH;  ++m  ) {
+		for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
+			statistics_buf[m][s] = stat( m, s );
+		}
+	}
 	if(  file->is_saving()  &&  file->is_version_less(120, 1)  ) {
 		for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-			statistics_buf[m][0] = (statistics[m][FAB_GOODS_STORAGE] >> DEFAULT_PRODUCTION_FACTOR_BITS);
-			statistics_buf[m][2] = (statistics[m][2] >> DEFAULT_PRODUCTION_FACTOR_BITS);
+			statistics_buf[m][0] = (stat( m, FAB_GOODS_STORAGE ) >> DEFAULT_PRODUCTION_FACTOR_BITS);
+			statistics_buf[m][2] = (stat( m, 2 ) >> DEFAULT_PRODUCTION_FACTOR_BITS);
 		}
 	}
 
@@ -166,7 +248,7 @@ void ware_production_t::rdwr(loadsave_t *file)
 				file->rdwr_longlong( statistics_buf[m][s] );
 			}
 		}
-		file->rdwr_longlong( weighted_sum_storage );
+		file->rdwr_longlong( weighted_sum_storage() );
 	}
 	else if(  file->is_version_atleast(110, 5)  ) {
 		// save/load statistics
@@ -175,23 +257,27 @@ void ware_production_t::rdwr(loadsave_t *file)
 				file->rdwr_longlong( statistics_buf[m][s] );
 			}
 		}
-		file->rdwr_longlong( weighted_sum_storage );
+		file->rdwr_longlong( weighted_sum_storage() );
 	}
 
 	if(  file->is_loading()  ) {
-		memcpy( statistics, statistics_buf, sizeof(statistics_buf) );
+		for(  int m=0;  m<MAX_MONTH;  ++m  ) {
+			for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
+				stat( m, s ) = statistics_buf[m][s];
+			}
+		}
 
 		// Apply correction for output production graphs which have had their precision changed for factory normalization.
 		// Also apply a fix for corrupted in-transit values caused by a logical error.
 		if(file->is_version_less(120, 1)){
 			for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-				statistics[m][0] = (statistics[m][FAB_GOODS_STORAGE] & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
-				statistics[m][2] = (statistics[m][2] & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
+				stat( m, 0 ) = (stat( m, FAB_GOODS_STORAGE ) & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
+				stat( m, 2 ) = (stat( m, 2 ) & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
 			}
 		}
 
 		// recalc transit always on load
-		statistics[0][FAB_GOODS_TRANSIT] = 0;
+		stat( 0, FAB_GOODS_TRANSIT ) = 0;
 	}
 
 	if (file->is_version_atleast(122, 1)) {
@@ -206,7 +292,7 @@ void ware_production_t::rdwr(loadsave_t *file)
 void ware_production_t::book_weighted_sum_storage(uint32 factor, sint64 delta_time)
 {
 	const sint64 amount = (sint64)menge * (sint64)factor;
-	weighted_sum_storage += amount * delta_time;
+	weighted_sum_storage() += amount * delta_time;
 	set_stat( amount, FAB_GOODS_STORAGE );
 }
 
@@ -1630,6 +1716,10 @@ uint32 fabrik_t::scale_output_production(const uint32 product, uint32 menge) con
 
 /************** TODO: properly handle more than one transformer! *******************************/
 
+#ifdef MULTI_THREAD
+static pthread_mutex_t power_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 void fabrik_t::set_power_supply(uint32 supply)
 {
 	if( transformers.empty() ) {
@@ -1639,7 +1729,14 @@ void fabrik_t::set_power_supply(uint32 supply)
 	if(  trans == NULL  ) {
 		return;
 	}
+#ifdef MULTI_THREAD
+	// the powernet is shared with other factories stepped at the same time
+	pthread_mutex_lock( &power_mutex );
+#endif
 	trans->set_power_supply(supply);
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &power_mutex );
+#endif
 }
 
 uint32 fabrik_t::get_power_supply() const
@@ -1675,7 +1772,14 @@ void fabrik_t::set_power_demand(uint32 demand)
 	if(  trans == NULL  ) {
 		return;
 	}
+#ifdef MULTI_THREAD
+	// the powernet is shared with other factories stepped at the same time
+	pthread_mutex_lock( &power_mutex );
+#endif
 	trans->set_power_demand(demand);
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &power_mutex );
+#endif
 }
 
 uint32 fabrik_t::get_power_demand() const
@@ -1848,7 +1952,7 @@ sint32 fabrik_t::get_jit2_power_boost() const
 }
 
 
-void fabrik_t::step(uint32 delta_t)
+void fabrik_t::step_production(uint32 delta_t)
 {
 	// Only do something if advancing in time.
 	if(  delta_t==0  ) {
@@ -2418,6 +2522,14 @@ void fabrik_t::step(uint32 delta_t)
 			break;
 		}
 	};
+}
+
+
+void fabrik_t::step(uint32 delta_t)
+{
+	if(  delta_t==0  ) {
+		return;
+	}
 
 	/// Periodic tasks.
 
@@ -2538,6 +2650,63 @@ public:
 };
 
 
+/* Routes found by verteile_waren() in this step. Factories ship again and again
+ * from the same stops to the same consumers, and the connections of the stops
+ * do not change until the next step. (Unless overcrowded stops are avoided,
+ * since the goods distributed in this step can make them overcrowded.)
+ */
+struct distribution_route_t
+{
+	int result;
+	halthandle_t ziel;
+	halthandle_t zwischenziel;
+};
+
+static inthashtable_tpl<uint64, distribution_route_t> distribution_routes;
+
+
+int fabrik_t::search_distribution_route(halthandle_t halt, ware_t &ware)
+{
+	if(  welt->get_settings().is_no_routing_over_overcrowding()  ) {
+		return haltestelle_t::search_route( &halt, 1U, true, ware );
+	}
+
+	// the hash uses the lower 32 bits only, so halt, goods and target are all mixed into them
+	const uint32 target = ((uint32)(uint16)ware.get_zielpos().x << 16) | (uint16)ware.get_zielpos().y;
+	const uint32 source = (uint32)halt.get_id() | ((uint32)ware.get_index() << 24);
+	const uint64 key = ((uint64)target << 32) | (source ^ target);
+	if(  const distribution_route_t *r = distribution_routes.access( key )  ) {
+		if(  r->result == haltestelle_t::ROUTE_OK  ||  r->result == haltestelle_t::ROUTE_WALK  ) {
+			if(  r->ziel.is_bound()  &&  (r->result == haltestelle_t::ROUTE_WALK  ||  r->zwischenziel.is_bound())  ) {
+				ware.set_ziel( r->ziel );
+				ware.set_zwischenziel( r->zwischenziel );
+				return r->result;
+			}
+			// a stop was removed meanwhile
+			distribution_routes.remove( key );
+		}
+		else {
+			ware.set_ziel( halthandle_t() );
+			ware.set_zwischenziel( halthandle_t() );
+			return r->result;
+		}
+	}
+
+	distribution_route_t r;
+	r.result = haltestelle_t::search_route( &halt, 1U, false, ware );
+	r.ziel = ware.get_ziel();
+	r.zwischenziel = ware.get_zwischenziel();
+	distribution_routes.put( key, r );
+	return r.result;
+}
+
+
+void fabrik_t::clear_distribution_routes()
+{
+	distribution_routes.clear();
+}
+
+
 /**
  * distribute stuff to all best destination
  */
@@ -2623,7 +2792,7 @@ void fabrik_t::verteile_waren(const uint32 product)
 		distribute_ware_t *best = NULL;
 		FOR(vector_tpl<distribute_ware_t>, & i, dist_list) {
 			// now search route
-			int const result = haltestelle_t::search_route(&i.halt, 1U, welt->get_settings().is_no_routing_over_overcrowding(), i.ware);
+			int const result = search_distribution_route( i.halt, i.ware );
 			if(  result == haltestelle_t::ROUTE_OK  ||  result == haltestelle_t::ROUTE_WALK  ) {
 				// we can deliver to this destination
 				best = &i;
@@ -2732,22 +2901,18 @@ void fabrik_t::new_month()
 		set_stat( weighted_sum_power / aggregate_weight, FAB_POWER );
 	}
 
-	// update statistics for input and output goods
+	// update statistics for input and output goods, karte_t moves them on with ware_production_t::roll_all_stats()
 	for(  uint32 in = 0;  in < input.get_count();  in++  ){
-		input[in].roll_stats( desc->get_supplier(in)->get_consumption(), aggregate_weight );
+		input[in].finish_month( desc->get_supplier(in)->get_consumption(), aggregate_weight );
 	}
 	for(  uint32 out = 0;  out < output.get_count();  out++  ){
-		output[out].roll_stats( desc->get_product(out)->get_factor(), aggregate_weight );
+		output[out].finish_month( desc->get_product(out)->get_factor(), aggregate_weight );
 	}
 	lieferziele_active_last_month = 0;
 
 	// advance statistics a month
-	for(  int s = 0;  s < MAX_FAB_STAT;  ++s  ) {
-		for(  int m = MAX_MONTH - 1;  m > 0;  --m  ) {
-			statistics[m][s] = statistics[m-1][s];
-		}
-		statistics[0][s] = 0;
-	}
+	memmove( statistics[1], statistics[0], sizeof(statistics[0]) * (MAX_MONTH-1) );
+	MEMZERO( statistics[0] );
 
 	weighted_sum_production = 0;
 	weighted_sum_boost_electric = 0;
@@ -3059,7 +3224,7 @@ void fabrik_t::finish_rd()
 
 	// now we have a valid storage limit
 	if(  welt->get_settings().is_crossconnect_factories()  ) {
-		FOR(  slist_tpl<fabrik_t*>,  const fab,  welt->get_fab_list()  ) {
+		FOR(  vector_tpl<fabrik_t*>,  const fab,  welt->get_fab_list()  ) {
 			fab->add_supplier(this);
 		}
 	}
@@ -3229,7 +3394,7 @@ void fabrik_t::add_all_suppliers()
 		const factory_supplier_desc_t *supplier = desc->get_supplier(i);
 		const goods_desc_t *ware = supplier->get_input_type();
 
-		FOR(slist_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
+		FOR(vector_tpl<fabrik_t*>, const fab, welt->get_fab_list()) {
 			// connect to an existing one, if this is an producer
 			if(fab!=this  &&  fab->vorrat_an(ware) > -1) {
 				// add us to this factory
@@ -107,54 +107,18 @@ sint64 convert_goods(sint64 value);
 sint64 convert_power(sint64 value);
 sint64 convert_boost(sint64 value);
 
+/**
+ * Stock and limits of one goods of a factory.
+ * The statistics and weighted sums of all factories are kept apart, see stats_chunk_t.
+ */
 class ware_production_t
 {
 private:
 	const goods_desc_t *type;
-	// statistics for each goods
-	sint64 statistics[MAX_MONTH][MAX_FAB_GOODS_STAT];
-	sint64 weighted_sum_storage;
 
-	/// clears statistics, transit, and weighted_sum_storage
-	void init_stats();
 public:
-	ware_production_t() : type(NULL), menge(0), max(0)/*, transit(statistics[0][FAB_GOODS_TRANSIT])*/,
-	                      max_transit(0), placing_orders(false), index_offset(0)
-	{
-#ifdef TRANSIT_DISTANCE
-		count_suppliers = 0;
-#endif
-		init_stats();
-	}
-
-	const goods_desc_t* get_typ() const { return type; }
-	void set_typ(const goods_desc_t *t) { type=t; }
-
-	// functions for manipulating goods statistics
-	void roll_stats(uint32 factor, sint64 aggregate_weight);
-	void rdwr(loadsave_t *file);
-	const sint64* get_stats() const { return *statistics; }
-	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics[0][stat_type] += value; }
-	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics[0][stat_type] = value; }
-	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_GOODS_STAT); return statistics[month][stat_type]; }
-
-	/**
-	 * convert internal units to displayed values
-	 */
-	sint64 get_stat_converted(int month, int stat_type) const {
-		assert(stat_type<MAX_FAB_GOODS_STAT);
-		sint64 value = statistics[month][stat_type];
-		if (stat_type==FAB_GOODS_STORAGE  ||  stat_type==FAB_GOODS_CONSUMED) {
-			value = convert_goods(value);
-		}
-		return value;
-	}
-	void book_weighted_sum_storage(uint32 factor, sint64 delta_time);
-
 	sint32 menge; // in internal units shifted by precision_bits (see step)
 	sint32 max;
-	/// Cargo currently in transit from/to this slot. Equivalent to statistics[0][FAB_GOODS_TRANSIT].
-	sint32 get_in_transit() const { return (sint32)statistics[0][FAB_GOODS_TRANSIT]; }
 
 	/// Annonmyous union used to save memory and readability. Contains supply flow control limiters.
 	union{
@@ -176,6 +140,80 @@ public:
 #endif
 	uint32 index_offset; // used for haltlist and lieferziele searches in verteile_waren to produce round robin results
 
+private:
+	enum { STATS_CHUNK_SLOTS = 256 };
+
+	/**
+	 * Statistics of the goods of all factories, as structure of arrays.
+	 * The months are planes, so roll_all_stats() moves a whole chunk at once.
+	 * Chunks never move, so get_stats() stays valid for charts.
+	 */
+	struct stats_chunk_t
+	{
+		sint64 statistics[MAX_MONTH][STATS_CHUNK_SLOTS][MAX_FAB_GOODS_STAT];
+		sint64 weighted_sum_storage[STATS_CHUNK_SLOTS];
+		/// FAB_GOODS_STORAGE of the next month, set by finish_month()
+		sint64 next_storage[STATS_CHUNK_SLOTS];
+	};
+
+	static vector_tpl<stats_chunk_t *> stats_chunks;
+	static vector_tpl<uint32> free_stats_slots;
+
+	stats_chunk_t *chunk;
+	uint32 stats_slot;
+
+	sint64 &stat(int month, int stat_type) const { return chunk->statistics[month][stats_slot & (STATS_CHUNK_SLOTS-1)][stat_type]; }
+	sint64 &weighted_sum_storage() const { return chunk->weighted_sum_storage[stats_slot & (STATS_CHUNK_SLOTS-1)]; }
+
+	void alloc_stats();
+
+	/// clears statistics, transit, and weighted_sum_storage
+	void init_stats();
+
+	/// copies all but the statistics slot
+	void copy_from(const ware_production_t &other);
+
+public:
+	ware_production_t();
+	ware_production_t(const ware_production_t &other);
+	~ware_production_t();
+	ware_production_t &operator=(const ware_production_t &other);
+
+	const goods_desc_t* get_typ() const { return type; }
+	void set_typ(const goods_desc_t *t) { type=t; }
+
+	// functions for manipulating goods statistics
+
+	/// the average storage of this month, the statistics move on with roll_all_stats()
+	void finish_month(uint32 factor, sint64 aggregate_weight);
+
+	/// starts a new month for the goods of all factories, after finish_month() of each
+	static void roll_all_stats();
+
+	void rdwr(loadsave_t *file);
+	const sint64* get_stats() const { return &stat( 0, 0 ); }
+	/// elements from one month to the next in get_stats()
+	static int get_stats_stride() { return STATS_CHUNK_SLOTS*MAX_FAB_GOODS_STAT; }
+	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); stat( 0, stat_type ) += value; }
+	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); stat( 0, stat_type ) = value; }
+	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_GOODS_STAT); return stat( month, stat_type ); }
+
+	/**
+	 * convert internal units to displayed values
+	 */
+	sint64 get_stat_converted(int month, int stat_type) const {
+		assert(stat_type<MAX_FAB_GOODS_STAT);
+		sint64 value = stat( month, stat_type );
+		if (stat_type==FAB_GOODS_STORAGE  ||  stat_type==FAB_GOODS_CONSUMED) {
+			value = convert_goods(value);
+		}
+		return value;
+	}
+	void book_weighted_sum_storage(uint32 factor, sint64 delta_time);
+
+	/// Cargo currently in transit from/to this slot. Equivalent to get_stat(0, FAB_GOODS_TRANSIT).
+	sint32 get_in_transit() const { return (sint32)stat( 0, FAB_GOODS_TRANSIT ); }
+
 	// Production rate for outputs. Returns fixed point with WORK_BITS fractional bits.
 	sint32 calculate_output_production_rate() const;
 
@@ -282,6 +320,9 @@ private:
 	 */
 	void verteile_waren(const uint32 product);
 
+	/// search_route() from @p halt for @p ware, reusing the routes found before in this step
+	static int search_distribution_route(halthandle_t halt, ware_t &ware);
+
 	// List of target cities
 	vector_tpl<stadt_t *> target_cities;
 
@@ -594,6 +635,15 @@ public:
 	 */
 	sint32 get_jit2_power_boost() const;
 
+	/**
+	 * Production, consumption, orders and power of this step.
+	 * Only changes this factory (and the powernet sums). But the distribution of
+	 * suppliers changes the demands and reads the storage of a consumer, so only
+	 * factories without input can do this before the other factories are stepped.
+	 */
+	void step_production(uint32 delta_t);
+
+	/// the rest of the step (distribution, expansion, ...), after step_production() of this factory
 	void step(uint32 delta_t);                  // factory muss auch arbeiten
 	void new_month();
 
@@ -626,6 +676,9 @@ public:
 	/// @returns a vector of factories within a rectangle
 	static vector_tpl<fabrik_t *> & sind_da_welche(koord min, koord max);
 
+	/// forgets the routes of search_distribution_route(), must be called after distributing the goods of a step
+	static void clear_distribution_routes();
+
 	// hier die methoden zum parametrisieren der Fabrik
 
 	/// Builds buildings (gebaeude_t) for the factory.
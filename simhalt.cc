@@ -20,6 +20,7 @@
 #include "simplan.h"
 #include "player/simplay.h"
 #include "gui/simwin.h"
+#include "sys/simsys.h"
 #include "simworld.h"
 #include "simware.h"
 
@@ -39,6 +40,7 @@
 #include "dataobj/loadsave.h"
 #include "dataobj/translator.h"
 #include "dataobj/environment.h"
+#include "dataobj/freight_store.h"
 
 #include "obj/gebaeude.h"
 #include "obj/label.h"
@@ -53,6 +55,10 @@
 
 #include "tpl/binary_heap_tpl.h"
 
+#ifdef MULTI_THREAD
+#include "utils/simthread.h"
+#endif
+
 #include "vehicle/simvehicle.h"
 #include "vehicle/pedestrian.h"
 
@@ -69,15 +75,85 @@ inthashtable_tpl<sint32,halthandle_t> *haltestelle_t::all_koords = NULL;
 
 uint8 haltestelle_t::status_step = 0;
 uint8 haltestelle_t::reconnect_counter = 0;
+vector_tpl<halthandle_t> haltestelle_t::dirty_halts;
+vector_tpl<halthandle_t> haltestelle_t::partial_halts;
+bool haltestelle_t::partial_step = false;
+
+// rows of the transfer tables calculated in each step_all()
+#define TRANSFER_TABLE_ROWS_PER_STEP (64)
+
+// packets rerouted in each step_all(), in single player adapted to take about REROUTE_TIME_PER_STEP ms
+#define REROUTE_BUDGET_MIN (128)
+#define REROUTE_BUDGET_MAX (65536)
+#define REROUTE_TIME_PER_STEP (4)
+// in network games, rerouting is spread over that many steps
+#define REROUTE_STEPS (16)
+
+sint32 haltestelle_t::reroute_budget = REROUTE_BUDGET_MIN;
+uint32 haltestelle_t::reroute_index = 0;
+
+bool haltestelle_t::finish_reconnecting = false;
+
+// the halts and results of compute_connected_components()
+struct component_entry_t
+{
+	uint32 halt_index;
+	quickstone_id_t comp;
+	uint8 catg;
+};
+static vector_tpl<haltestelle_t *> components_halts;
+static vector_tpl<component_entry_t> components_result;
+static quickstone_id_t components_id_count = 0;
+static bool components_running = false;
+#ifdef MULTI_THREAD
+static pthread_t components_thread;
+#endif
 
 
 static vector_tpl<convoihandle_t>stale_convois;
 static vector_tpl<linehandle_t>stale_lines;
 
+// new halts must not disturb a resumed search_route_resumable()
+static void mark_new_halt(halthandle_t halt);
+
 
 void haltestelle_t::reset_routing()
 {
-	reconnect_counter = welt->get_schedule_counter()-1;
+	reconnect_counter = welt->get_reconnect_all_counter()-1;
+	forget_dirty_halts();
+}
+
+
+void haltestelle_t::forget_dirty_halts()
+{
+	FOR(vector_tpl<halthandle_t>, const halt, dirty_halts) {
+		if(  halt.is_bound()  ) {
+			halt->connections_dirty = false;
+		}
+	}
+	dirty_halts.clear();
+	partial_halts.clear();
+	partial_step = false;
+}
+
+
+void haltestelle_t::set_connections_dirty()
+{
+	if(  !connections_dirty  ) {
+		connections_dirty = true;
+		dirty_halts.append( self );
+	}
+}
+
+
+void haltestelle_t::set_connections_dirty(const schedule_t *schedule, const player_t *owner)
+{
+	FOR(minivec_tpl<schedule_entry_t>, const& i, schedule->entries) {
+		halthandle_t const halt = get_halt(i.pos, owner);
+		if(  halt.is_bound()  ) {
+			halt->set_connections_dirty();
+		}
+	}
 }
 
 
@@ -98,39 +174,171 @@ void haltestelle_t::step_all()
 		}
 	}
 
-	static vector_tpl<halthandle_t>::iterator iter( alle_haltestellen.begin() );
 	if (alle_haltestellen.empty()) {
 		return;
 	}
-	const uint8 schedule_counter = welt->get_schedule_counter();
+
+	if(  finish_reconnecting  ) {
+		// the connected components were computed since the last call
+		finish_reconnecting = false;
+		wait_connected_components();
+		plan_transfer_tables();
+		if(  partial_step  ) {
+			// reroute only in networks containing a changed halt
+			collect_rerouted_halts( partial_halts );
+		}
+		reroute_index = 0;
+		start_rerouting( partial_step ? partial_halts : alle_haltestellen );
+	}
+
+	const uint8 schedule_counter = welt->get_reconnect_all_counter();
 	if (reconnect_counter != schedule_counter) {
 		// always start with reconnection, re-routing will happen after complete reconnection
 		status_step = RECONNECTING;
 		reconnect_counter = schedule_counter;
-		iter = alle_haltestellen.begin();
+		// this round reconnects the dirty halts too
+		forget_dirty_halts();
+		drop_transfer_tables();
+	}
+	else if(  status_step == 0  &&  !dirty_halts.empty()  ) {
+		// only the stops of changed schedules need new connections
+		status_step = RECONNECTING;
+		partial_step = true;
+		partial_halts.clear();
+		swap( partial_halts, dirty_halts );
+		drop_transfer_tables();
+		FOR(vector_tpl<halthandle_t>, const halt, partial_halts) {
+			if(  halt.is_bound()  ) {
+				halt->connections_dirty = false;
+			}
+		}
 	}
 
-	sint16 units_remaining = 128;
-	for (; iter != alle_haltestellen.end(); ++iter) {
-		if (units_remaining <= 0) return;
+	if(  status_step == RECONNECTING  ) {
+		// the connections of a halt only depend on the schedules serving it => all at once
+		const vector_tpl<halthandle_t> &halts = partial_step ? partial_halts : alle_haltestellen;
+		welt->rebuild_halt_connections( halts );
+	}
+	else {
+		build_transfer_tables( TRANSFER_TABLE_ROWS_PER_STEP );
+	}
 
-		// iterate until the specified number of units were handled
-		if(  !(*iter)->step(status_step, units_remaining)  ) {
+	if(  status_step == REROUTING  ) {
+		const vector_tpl<halthandle_t> &halts = partial_step ? partial_halts : alle_haltestellen;
+		if(  !reroute_halts( halts, reroute_index )  ) {
 			// too much rerouted => needs to continue at next round!
 			return;
 		}
+		status_step = 0;
+		partial_step = false;
+		partial_halts.clear();
+		return;
 	}
 
 	if (status_step == RECONNECTING) {
-		// reconnecting finished, compute connected components in one sweep
-		rebuild_connected_components();
-		// reroute in next call
+		// reconnecting finished, compute connected components until the next call, then reroute
+		start_connected_components();
+		finish_reconnecting = true;
 		status_step = REROUTING;
 	}
-	else if (status_step == REROUTING) {
-		status_step = 0;
+}
+
+
+void haltestelle_t::start_rerouting(const vector_tpl<halthandle_t> &halts)
+{
+	if(  !env_t::networkmode  ) {
+		// keep the budget adapted to the time of the last rerouting
+		return;
 	}
-	iter = alle_haltestellen.begin();
+	// the step time differs between server and clients => budget from the amount of waiting packets
+	uint32 packets = 0;
+	FOR(vector_tpl<halthandle_t>, const halt, halts) {
+		if(  halt.is_bound()  ) {
+			for(  uint8 i=0;  i<goods_manager_t::get_max_catg_index();  i++  ) {
+				if(  halt->cargo[i]  ) {
+					packets += halt->cargo[i]->get_count();
+				}
+			}
+		}
+	}
+	reroute_budget = clamp( (sint32)(packets / REROUTE_STEPS), REROUTE_BUDGET_MIN, REROUTE_BUDGET_MAX );
+}
+
+
+bool haltestelle_t::reroute_halts(const vector_tpl<halthandle_t> &halts, uint32 &index)
+{
+	sint32 units_remaining = reroute_budget;
+	const uint32 start_time = dr_time();
+
+	bool finished = true;
+	for(  ;  index < halts.get_count();  index++  ) {
+		// iterate until the specified number of units were handled
+		halthandle_t halt = halts[index];
+		if(  units_remaining <= 0  ||  (halt.is_bound()  &&  !halt->step(REROUTING, units_remaining))  ) {
+			finished = false;
+			break;
+		}
+	}
+
+	if(  !env_t::networkmode  &&  units_remaining <= 0  ) {
+		// used up the budget => adapt it to the time it took
+		const uint32 time = dr_time() - start_time;
+		if(  time < REROUTE_TIME_PER_STEP/2  ) {
+			reroute_budget = min( reroute_budget*2, REROUTE_BUDGET_MAX );
+		}
+		else if(  time > REROUTE_TIME_PER_STEP  ) {
+			reroute_budget = max( reroute_budget/2, REROUTE_BUDGET_MIN );
+		}
+	}
+	return finished;
+}
+
+
+void haltestelle_t::collect_rerouted_halts(vector_tpl<halthandle_t> &halts)
+{
+	// one bit per connected component (i.e. halt id) and category
+	const uint32 catg_count = goods_manager_t::get_max_catg_index();
+	const uint32 bytes_per_catg = halthandle_t::get_size()/8 + 1;
+	uint8 *changed = MALLOCN(uint8, catg_count*bytes_per_catg);
+	memset( changed, 0, catg_count*bytes_per_catg );
+
+	FOR(vector_tpl<halthandle_t>, const halt, halts) {
+		if(  halt.is_bound()  ) {
+			for(  uint32 i=0;  i<catg_count;  i++  ) {
+				const quickstone_id_t comp = halt->all_links[i].catg_connected_component;
+				if(  comp != UNDECIDED_CONNECTED_COMPONENT  ) {
+					changed[i*bytes_per_catg + comp/8] |= 1 << (comp & 7);
+				}
+			}
+		}
+	}
+
+	// the changed halts themselves most likely lost connections => reroute them first
+	uint8 *queued = MALLOCN(uint8, bytes_per_catg);
+	memset( queued, 0, bytes_per_catg );
+	vector_tpl<halthandle_t> changed_halts;
+	swap( changed_halts, halts );
+	FOR(vector_tpl<halthandle_t>, const halt, changed_halts) {
+		if(  halt.is_bound()  &&  !(queued[halt.get_id()/8] & (1 << (halt.get_id() & 7)))  ) {
+			queued[halt.get_id()/8] |= 1 << (halt.get_id() & 7);
+			halts.append( halt );
+		}
+	}
+
+	FOR(vector_tpl<halthandle_t>, const halt, alle_haltestellen) {
+		if(  queued[halt.get_id()/8] & (1 << (halt.get_id() & 7))  ) {
+			continue;
+		}
+		for(  uint32 i=0;  i<catg_count;  i++  ) {
+			const quickstone_id_t comp = halt->all_links[i].catg_connected_component;
+			if(  comp != UNDECIDED_CONNECTED_COMPONENT  &&  (changed[i*bytes_per_catg + comp/8] & (1 << (comp & 7)))  ) {
+				halts.append( halt );
+				break;
+			}
+		}
+	}
+	free( queued );
+	free( changed );
 }
 
 
@@ -393,9 +601,13 @@ void haltestelle_t::destroy_all()
 		halthandle_t halt = alle_haltestellen.back();
 		destroy(halt);
 	}
+	wait_connected_components();
 	delete all_koords;
 	all_koords = NULL;
 	status_step = 0;
+	finish_reconnecting = false;
+	reset_routing();
+	drop_transfer_tables();
 }
 
 
@@ -403,14 +615,15 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 {
 	last_loading_step = welt->get_steps();
 
-	cargo = (slist_tpl<ware_t> **)calloc( goods_manager_t::get_max_catg_index(), sizeof(slist_tpl<ware_t> *) );
+	cargo = (freight_store_t **)calloc( goods_manager_t::get_max_catg_index(), sizeof(freight_store_t *) );
 	all_links = new link_t[ goods_manager_t::get_max_catg_index() ];
 
 	status_color = SYSCOL_TEXT_UNUSED;
 	last_status_color = color_idx_to_rgb(COL_PURPLE);
 	last_bar_count = 0;
 
-	reconnect_counter = welt->get_schedule_counter()-1;
+	reconnect_counter = welt->get_reconnect_all_counter()-1;
+	connections_dirty = false;
 
 	enables = NOT_ENABLED;
 
@@ -419,7 +632,7 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 
 	rdwr(file);
 
-	markers[ self.get_id() ] = current_marker;
+	mark_new_halt( self );
 
 	alle_haltestellen.append(self);
 }
@@ -431,7 +644,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	assert( !alle_haltestellen.is_contained(self) );
 	alle_haltestellen.append(self);
 
-	markers[ self.get_id() ] = current_marker;
+	mark_new_halt( self );
 
 	last_loading_step = welt->get_steps();
 
@@ -440,10 +653,11 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 
 	enables = NOT_ENABLED;
 	// force total re-routing
-	reconnect_counter = welt->get_schedule_counter()-1;
+	reconnect_counter = welt->get_reconnect_all_counter()-1;
+	connections_dirty = false;
 	last_catg_index = 255;
 
-	cargo = (slist_tpl<ware_t> **)calloc( goods_manager_t::get_max_catg_index(), sizeof(slist_tpl<ware_t> *) );
+	cargo = (freight_store_t **)calloc( goods_manager_t::get_max_catg_index(), sizeof(freight_store_t *) );
 	all_links = new link_t[ goods_manager_t::get_max_catg_index() ];
 
 	status_color = SYSCOL_TEXT_UNUSED;
@@ -459,6 +673,9 @@ haltestelle_t::~haltestelle_t()
 {
 	assert(self.is_bound());
 
+	// the background search reads our connections
+	wait_connected_components();
+
 	// first: remove halt from all lists
 	int i=0;
 	while(alle_haltestellen.is_contained(self)) {
@@ -501,14 +718,17 @@ haltestelle_t::~haltestelle_t()
 
 	destroy_win( magic_halt_info + self.get_id() );
 
+	// its handle may be reused by the next new halt
+	drop_transfer_tables();
+
 	// finally detach handle
 	// before it is needed for clearing up the planqudrat and tiles
 	self.detach();
 
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if (cargo[i]) {
-			FOR(slist_tpl<ware_t>, const &w, *cargo[i]) {
-				fabrik_t::update_transit(&w, false);
+			for(  uint32 pos = 0;  pos < cargo[i]->get_count();  pos++  ) {
+				fabrik_t::update_transit( &(*cargo[i])[pos], false );
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
@@ -530,16 +750,14 @@ void haltestelle_t::rotate90( const sint16 y_size )
 	// iterate over all different categories
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if(cargo[i]) {
-			slist_tpl<ware_t>& warray = *cargo[i];
-			for (  slist_tpl<ware_t>::iterator ware = warray.begin();  ware!=warray.end();  ) {
-				if(  ware->menge>0  ) {
-					ware->rotate90(y_size);
-					ware ++;
-				} else {
-					// empty => remove
-					ware = warray.erase(ware);
+			freight_store_t& warray = *cargo[i];
+			for(  uint32 pos = 0;  pos < warray.get_count();  pos++  ) {
+				if(  warray[pos].menge>0  ) {
+					warray[pos].rotate90(y_size);
 				}
 			}
+			// empty => remove, and rehash the target positions
+			warray.compact();
 		}
 	}
 
@@ -968,7 +1186,7 @@ bool haltestelle_t::has_available_network(const player_t* player, uint8 catg_ind
 
 
 
-bool haltestelle_t::step(uint8 what, sint16 &units_remaining)
+bool haltestelle_t::step(uint8 what, sint32 &units_remaining)
 {
 	switch(what) {
 		case RECONNECTING:
@@ -1013,12 +1231,32 @@ void haltestelle_t::new_month()
 
 
 
+bool haltestelle_t::is_linked(halthandle_t halt, uint8 catg_index) const
+{
+	const vector_tpl<connection_t> &connections = all_links[catg_index].connections;
+	// connections are sorted by halt id
+	uint32 lo = 0, hi = connections.get_count();
+	while(  lo < hi  ) {
+		const uint32 mid = (lo + hi) / 2;
+		if(  connections[mid].halt.get_id() < halt.get_id()  ) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return lo < connections.get_count()  &&  connections[lo].halt == halt;
+}
+
+
 /**
  * Called after schedule calculation of all stations is finished
  * will distribute the goods to changed routes (if there are any)
+ * Only goods whose next stop or destination cannot be reached anymore get a new route,
+ * each new route costs one unit.
  * returns true upon completion
  */
-bool haltestelle_t::reroute_goods(sint16 &units_remaining)
+bool haltestelle_t::reroute_goods(sint32 &units_remaining)
 {
 	if(  last_catg_index==255  ) {
 		last_catg_index = 0;
@@ -1034,23 +1272,20 @@ bool haltestelle_t::reroute_goods(sint16 &units_remaining)
 		}
 
 		// first: clean out the array
-		slist_tpl<ware_t> * warray = cargo[last_catg_index];
-		for (  slist_tpl<ware_t>::iterator ware = warray->begin(); ware!=warray->end();  ) {
-			if(  ware->menge==0  ) {
-				ware = warray->erase(ware);
-				continue;
-			}
+		freight_store_t * warray = cargo[last_catg_index];
+		for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+			const ware_t &ware = (*warray)[pos];
 			// since also the factory halt list is added to the ground, we can use just this ...
-			else if(  welt->access(ware->get_zielpos())->is_connected(self)  ) {
+			if(  ware.menge>0  &&  welt->access(ware.get_zielpos())->is_connected(self)  ) {
 				// we are already there!
-				if(  ware->to_factory  ) {
-					liefere_an_fabrik(*ware);
+				if(  ware.to_factory  ) {
+					liefere_an_fabrik(ware);
 				}
-				ware = warray->erase(ware);
-				continue;
+				warray->remove(pos);
 			}
-			ware ++;
 		}
+		warray->compact();
+		units_remaining -= (warray->get_count()/256)+1;
 
 		// delete, if nothing connects here
 		if(  warray->empty()  &&  all_links[last_catg_index].connections.empty()  ) {
@@ -1061,21 +1296,51 @@ bool haltestelle_t::reroute_goods(sint16 &units_remaining)
 		}
 
 		// if something left
-		// re-route goods to adapt to changes in world layout,
+		// re-route goods which lost their next stop or their destination,
 		// remove all goods whose destination was removed from the map
-		for(  slist_tpl<ware_t>::iterator ware = warray->begin();  ware!=warray->end();  ) {
-			search_route_resumable(*ware);
-			if(  ware->get_ziel()==halthandle_t()  ) {
+		bool finished = true;
+		bool rerouted = false;
+		halthandle_t last_via;
+		bool last_via_linked = false;
+		for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+			ware_t &ware = (*warray)[pos];
+			if(  ware.menge==0  ||  !ware.get_zwischenziel().is_bound()  ) {
+				// empty or returning goods, the latter are routed before loading
+				continue;
+			}
+			if(  ware.get_zwischenziel()!=last_via  ) {
+				last_via = ware.get_zwischenziel();
+				last_via_linked = is_linked( last_via, last_catg_index );
+			}
+			if(  last_via_linked  &&  is_connected( ware.get_ziel(), last_catg_index )==1  ) {
+				// route still possible
+				continue;
+			}
+			if(  units_remaining<=0  ) {
+				// continue at next step
+				finished = false;
+				break;
+			}
+			units_remaining--;
+			rerouted = true;
+			search_route_resumable(ware);
+			if(  ware.get_ziel()==halthandle_t()  ) {
 				// remove invalid destinations
-				const ware_t w = *ware;
-				fabrik_t::update_transit( &w, false);
-				ware = warray->erase(ware);
+				fabrik_t::update_transit( &ware, false);
+				warray->remove(pos);
 			}
 			else {
-				ware++;
+				warray->update(pos);
 			}
 		}
-
+		if(  rerouted  ||  warray->needs_compaction()  ) {
+			// drop the old next stops from the index
+			warray->compact();
+		}
+		if(  !finished  ) {
+			resort_freight_info = true;
+			return false;
+		}
 	}
 	// likely the display must be updated after this
 	resort_freight_info = true;
@@ -1144,15 +1409,20 @@ void haltestelle_t::remove_fabriken(fabrik_t *fab)
 #define WEIGHT_MIN (WEIGHT_WAIT+WEIGHT_HALT)
 sint32 haltestelle_t::rebuild_connections()
 {
-	// halts which either immediately precede or succeed self halt in serving schedules
-	static vector_tpl<halthandle_t> consecutive_halts[256];
-	// halts which either immediately precede or succeed self halt in currently processed schedule
-	static vector_tpl<halthandle_t> consecutive_halts_schedule[256];
+	static reconnect_scratch_t scratch;
+	wait_connected_components();
+	return rebuild_connections( scratch );
+}
+
+
+sint32 haltestelle_t::rebuild_connections(reconnect_scratch_t &scratch, bool interruptible)
+{
+	vector_tpl<halthandle_t> *consecutive_halts = scratch.consecutive_halts;
+	vector_tpl<halthandle_t> *consecutive_halts_schedule = scratch.consecutive_halts_schedule;
 	// remember max number of consecutive halts for one schedule
 	uint8 max_consecutive_halts_schedule[256];
 	MEMZERON(max_consecutive_halts_schedule, goods_manager_t::get_max_catg_index());
-	// previous halt supporting the ware categories of the serving line
-	static halthandle_t previous_halt[256];
+	halthandle_t *previous_halt = scratch.previous_halt;
 
 	// first, remove all old entries
 	for(  uint8 i=0;  i<goods_manager_t::get_max_catg_index();  i++  ){
@@ -1242,7 +1512,9 @@ sint32 haltestelle_t::rebuild_connections()
 			continue;
 		}
 
-		INT_CHECK("simhalt.cc 612");
+		if(  interruptible  ) {
+			INT_CHECK("simhalt.cc 612");
+		}
 
 		minivec_tpl<halthandle_t> no_unload_halts;
 
@@ -1333,6 +1605,7 @@ sint32 haltestelle_t::rebuild_connections()
 
 void haltestelle_t::rebuild_linked_connections()
 {
+	drop_transfer_tables();
 	vector_tpl<halthandle_t> all; // all halts connected to this halt
 	for(  uint8 i=0;  i<goods_manager_t::get_max_catg_index();  i++  ){
 		vector_tpl<connection_t>& connections = all_links[i].connections;
@@ -1347,32 +1620,151 @@ void haltestelle_t::rebuild_linked_connections()
 }
 
 
-void haltestelle_t::fill_connected_component(uint8 catg_idx, uint16 comp)
+void haltestelle_t::rebuild_connected_components()
+{
+	wait_connected_components();
+	prepare_connected_components();
+	compute_connected_components();
+	apply_connected_components();
+}
+
+
+void haltestelle_t::start_connected_components()
 {
-	if (all_links[catg_idx].catg_connected_component != UNDECIDED_CONNECTED_COMPONENT) {
-		// already connected
+	wait_connected_components();
+	prepare_connected_components();
+	components_running = true;
+#ifdef MULTI_THREAD
+	pthread_attr_t attr;
+	pthread_attr_init( &attr );
+	pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_JOINABLE );
+	if(  pthread_create( &components_thread, &attr, connected_components_thread, NULL )  ) {
+		dbg->error( "haltestelle_t::start_connected_components()", "cannot create thread" );
+		compute_connected_components();
+		components_running = false;
+		apply_connected_components();
+	}
+	pthread_attr_destroy( &attr );
+#else
+	compute_connected_components();
+#endif
+}
+
+
+void *haltestelle_t::connected_components_thread(void *)
+{
+	compute_connected_components();
+	return NULL;
+}
+
+
+void haltestelle_t::wait_connected_components()
+{
+	if(  !components_running  ) {
 		return;
 	}
-	all_links[catg_idx].catg_connected_component = comp;
+#ifdef MULTI_THREAD
+	pthread_join( components_thread, NULL );
+#endif
+	components_running = false;
+	apply_connected_components();
+}
+
 
-	FOR(vector_tpl<connection_t>, &c, all_links[catg_idx].connections) {
-		c.halt->fill_connected_component(catg_idx, comp);
-		// cache the is_transfer value
-		c.is_transfer = c.halt->is_transfer(catg_idx);
+void haltestelle_t::prepare_connected_components()
+{
+	components_halts.clear();
+	components_halts.resize( alle_haltestellen.get_count() );
+	FOR(vector_tpl<halthandle_t>, const halt, alle_haltestellen) {
+		components_halts.append( halt.get_rep() );
+		for(  uint8 catg_idx=0;  catg_idx<goods_manager_t::get_max_catg_index();  catg_idx++  ) {
+			// networks may have been joined or split
+			halt->all_links[catg_idx].catg_connected_component = UNDECIDED_CONNECTED_COMPONENT;
+			FOR(vector_tpl<connection_t>, &c, halt->all_links[catg_idx].connections) {
+				// cache the is_transfer value
+				c.is_transfer = c.halt.is_bound()  &&  c.halt->is_transfer(catg_idx);
+			}
+		}
 	}
+	// the handle table may grow meanwhile
+	components_id_count = halthandle_t::get_size();
 }
 
 
-void haltestelle_t::rebuild_connected_components()
+void haltestelle_t::compute_connected_components()
+{
+	const uint32 halt_count = components_halts.get_count();
+	const uint8 catg_count = goods_manager_t::get_max_catg_index();
+	components_result.clear();
+
+	// snapshot index of each halt id
+	uint32 *index_of = MALLOCN( uint32, components_id_count );
+	memset( index_of, 0xFF, sizeof(uint32)*components_id_count );
+	for(  uint32 i=0;  i<halt_count;  i++  ) {
+		index_of[ components_halts[i]->self.get_id() ] = i;
+	}
+
+	// depth-first search like the former recursion: in order of alle_haltestellen, each undecided
+	// halt gets its own id and passes it along the (directed) connections to all undecided halts it reaches
+	uint8 *decided = MALLOCN( uint8, halt_count );
+	memset( decided, 0, halt_count );
+	vector_tpl<uint32> open;
+
+	for(  uint8 catg_idx=0;  catg_idx<catg_count;  catg_idx++  ) {
+		// marks the decided halts of this category without clearing the array
+		const uint8 mark = catg_idx+1;
+		for(  uint32 root=0;  root<halt_count;  root++  ) {
+			if(  decided[root] == mark  ) {
+				continue;
+			}
+			decided[root] = mark;
+			if(  components_halts[root]->all_links[catg_idx].connections.empty()  ) {
+				// its own component, set by apply_connected_components()
+				continue;
+			}
+			const quickstone_id_t comp = components_halts[root]->self.get_id();
+			open.clear();
+			open.append( root );
+			while(  !open.empty()  ) {
+				const uint32 i = open.pop_back();
+				component_entry_t entry;
+				entry.halt_index = i;
+				entry.comp = comp;
+				entry.catg = catg_idx;
+				components_result.append( entry );
+
+				FOR(vector_tpl<connection_t>, const &c, components_halts[i]->all_links[catg_idx].connections) {
+					const quickstone_id_t id = c.halt.get_id();
+					const uint32 j = id < components_id_count ? index_of[id] : 0xFFFFFFFFu;
+					if(  j != 0xFFFFFFFFu  &&  decided[j] != mark  ) {
+						decided[j] = mark;
+						open.append( j );
+					}
+				}
+			}
+		}
+	}
+
+	free( decided );
+	free( index_of );
+}
+
+
+void haltestelle_t::apply_connected_components()
 {
-	for(uint8 catg_idx = 0; catg_idx<goods_manager_t::get_max_catg_index(); catg_idx++) {
-		FOR(vector_tpl<halthandle_t>, halt, alle_haltestellen) {
-			if (halt->all_links[catg_idx].catg_connected_component == UNDECIDED_CONNECTED_COMPONENT) {
-				// start recursion
-				halt->fill_connected_component(catg_idx, halt.get_id());
+	FOR(vector_tpl<component_entry_t>, const &entry, components_result) {
+		components_halts[entry.halt_index]->all_links[entry.catg].catg_connected_component = entry.comp;
+	}
+	// unconnected halts are their own component
+	FOR(vector_tpl<haltestelle_t *>, const halt, components_halts) {
+		for(  uint8 catg_idx=0;  catg_idx<goods_manager_t::get_max_catg_index();  catg_idx++  ) {
+			if(  halt->all_links[catg_idx].catg_connected_component == UNDECIDED_CONNECTED_COMPONENT  ) {
+				halt->all_links[catg_idx].catg_connected_component = halt->self.get_id();
 			}
 		}
 	}
+	components_halts.clear();
+	components_result.clear();
 }
 
 
@@ -1491,15 +1883,359 @@ public:
 /**
  * Data for route searching
  */
-haltestelle_t::halt_data_t haltestelle_t::halt_data[65536];
-bucket_heap_tpl<haltestelle_t::route_node_t> haltestelle_t::open_list;
-uint8 haltestelle_t::markers[65536];
-uint8 haltestelle_t::current_marker = 0;
+struct haltestelle_t::route_search_memory_t
+{
+	// store the best weight so far for a halt, and indicate whether it is a destination
+	halt_data_t *halt_data;
+
+	// for efficient retrieval of the node with the smallest weight
+	bucket_heap_tpl<route_node_t> open_list;
+
+	// markers used in route searching to avoid processing the same halt more than once
+	uint8 *markers;
+	uint8 current_marker;
+
+	// number of halt indices covered by halt_data and markers
+	quickstone_id_t capacity;
+
+	// target halts and their connected components
+	vector_tpl<halthandle_t> end_halts;
+	vector_tpl<quickstone_id_t> end_conn_comp;
+
+	route_search_memory_t() : halt_data(NULL), markers(NULL), current_marker(0), capacity(0), end_halts(16), end_conn_comp(16) {}
+
+	~route_search_memory_t()
+	{
+		delete [] halt_data;
+		free( markers );
+	}
+
+	// grows the arrays to all current halt indices, keeping their contents
+	void reserve()
+	{
+		const quickstone_id_t size = halthandle_t::get_size();
+		if(  capacity >= size  ) {
+			return;
+		}
+		halt_data_t *new_halt_data = new halt_data_t[size];
+		for(  quickstone_id_t i=0;  i<capacity;  i++  ) {
+			new_halt_data[i] = halt_data[i];
+		}
+		delete [] halt_data;
+		halt_data = new_halt_data;
+		markers = REALLOC( markers, uint8, size );
+		MEMZERON( markers+capacity, size-capacity );
+		capacity = size;
+	}
+};
+
+// used by the main thread, also by search_route_resumable()
+static haltestelle_t::route_search_memory_t main_search_memory;
+
+static void mark_new_halt(halthandle_t halt)
+{
+	main_search_memory.reserve();
+	main_search_memory.markers[ halt.get_id() ] = main_search_memory.current_marker;
+}
+
+static vector_tpl<haltestelle_t::route_search_memory_t *> free_search_memory;
+#ifdef MULTI_THREAD
+static pthread_mutex_t search_memory_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+haltestelle_t::route_search_memory_t *haltestelle_t::get_route_search_memory()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &search_memory_mutex );
+#endif
+	route_search_memory_t *memory = free_search_memory.empty() ? new route_search_memory_t() : free_search_memory.pop_back();
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &search_memory_mutex );
+#endif
+	return memory;
+}
+
+
+void haltestelle_t::release_route_search_memory(route_search_memory_t *memory)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &search_memory_mutex );
+#endif
+	free_search_memory.append( memory );
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &search_memory_mutex );
+#endif
+}
+
 /**
  * Data for resumable route search
  */
 halthandle_t haltestelle_t::last_search_origin;
 uint8 haltestelle_t::last_search_ware_catg_idx = 255;
+
+/**
+ * Precomputed routes
+ */
+vector_tpl<haltestelle_t::transfer_table_t *> haltestelle_t::transfer_tables;
+inthashtable_tpl<uint32, haltestelle_t::transfer_table_t *> haltestelle_t::transfer_table_of;
+uint32 haltestelle_t::transfer_tables_done = 0;
+
+
+void haltestelle_t::drop_transfer_tables()
+{
+	FOR(vector_tpl<transfer_table_t *>, table, transfer_tables) {
+		delete table;
+	}
+	transfer_tables.clear();
+	transfer_table_of.clear();
+	transfer_tables_done = 0;
+}
+
+
+void haltestelle_t::plan_transfer_tables()
+{
+	drop_transfer_tables();
+	const uint64 memory = (uint64)welt->get_settings().get_transfer_table_memory() << 20;
+	if(  memory == 0  ) {
+		return;
+	}
+
+	for(  uint8 catg_idx = 0;  catg_idx < goods_manager_t::get_max_catg_index();  catg_idx++  ) {
+		FOR(vector_tpl<halthandle_t>, const halt, alle_haltestellen) {
+			link_t &link = halt->all_links[catg_idx];
+			if(  link.connections.empty()  ||  link.catg_connected_component == UNDECIDED_CONNECTED_COMPONENT  ) {
+				continue;
+			}
+			const uint32 key = transfer_table_key( catg_idx, link.catg_connected_component );
+			transfer_table_t *table = transfer_table_of.get( key );
+			if(  table == NULL  ) {
+				table = new transfer_table_t( catg_idx );
+				transfer_tables.append( table );
+				transfer_table_of.set( key, table );
+			}
+			link.transfer_index = table->halts.get_count();
+			table->halts.append( halt );
+		}
+	}
+
+	// keep the tables in order of creation as long as they fit
+	uint64 used = 0;
+	uint32 kept = 0;
+	FOR(vector_tpl<transfer_table_t *>, table, transfer_tables) {
+		const uint64 count = table->halts.get_count();
+		const uint64 size = count * count * sizeof(transfer_entry_t);
+		if(  count < 0xffff  &&  used + size <= memory  ) {
+			used += size;
+			table->entries = MALLOCN( transfer_entry_t, count * count );
+			transfer_tables[kept++] = table;
+		}
+		else {
+			const uint8 catg_idx = table->catg_idx;
+			halthandle_t halt = table->halts[0];
+			transfer_table_of.remove( transfer_table_key( catg_idx, halt->all_links[catg_idx].catg_connected_component ) );
+			delete table;
+		}
+	}
+	while(  transfer_tables.get_count() > kept  ) {
+		transfer_tables.pop_back();
+	}
+	if(  !transfer_tables.empty()  ) {
+		DBG_MESSAGE( "haltestelle_t::plan_transfer_tables()", "%u tables with %llu bytes", kept, (unsigned long long)used );
+	}
+}
+
+
+void haltestelle_t::build_transfer_tables(uint32 max_rows)
+{
+	while(  max_rows > 0  &&  transfer_tables_done < transfer_tables.get_count()  ) {
+		transfer_table_t &table = *transfer_tables[transfer_tables_done];
+		for(  ;  max_rows > 0  &&  !table.is_complete();  max_rows--  ) {
+			calc_transfer_row( table, table.rows_done );
+			table.rows_done++;
+		}
+		if(  table.is_complete()  ) {
+			transfer_tables_done++;
+		}
+	}
+}
+
+
+/**
+ * Dijkstra from a single start halt to all halts of its table.
+ * Like in search_route() only transfer halts are passed through.
+ */
+void haltestelle_t::calc_transfer_row(transfer_table_t &table, uint16 start)
+{
+	struct node_t
+	{
+		uint16 index;
+		uint16 weight;
+
+		node_t() : index(0), weight(0) {}
+		node_t(uint16 i, uint16 w) : index(i), weight(w) {}
+
+		inline uint16 operator * () const { return weight; }
+	};
+	static binary_heap_tpl<node_t> open(128);
+	static vector_tpl<bool> closed;
+
+	const uint8 catg_idx = table.catg_idx;
+	const uint32 count = table.halts.get_count();
+	transfer_entry_t *const row = table.entries + start * count;
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		row[i].weight = 0xffff;
+		row[i].first  = 0xffff;
+		row[i].last   = 0xffff;
+		row[i].depth  = 0;
+	}
+	closed.clear();
+	closed.resize( count );
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		closed.append( false );
+	}
+
+	open.clear();
+	row[start].weight = 0;
+	open.insert( node_t(start, 0) );
+	while(  !open.empty()  ) {
+		const uint16 current = open.pop().index;
+		if(  closed[current]  ) {
+			continue;
+		}
+		closed[current] = true;
+
+		const transfer_entry_t &current_entry = row[current];
+		halthandle_t const halt = table.halts[current];
+		if(  current != start  &&  !halt->is_transfer( catg_idx )  ) {
+			// only a possible destination
+			continue;
+		}
+
+		FOR(vector_tpl<connection_t>, const& conn, halt->all_links[catg_idx].connections) {
+			if(  !conn.halt.is_bound()  ) {
+				continue;
+			}
+			const uint16 next = conn.halt->all_links[catg_idx].transfer_index;
+			if(  next >= count  ||  table.halts[next] != conn.halt  ) {
+				continue;
+			}
+			const uint32 weight = (uint32)current_entry.weight + conn.weight;
+			if(  weight >= 0xffff  ) {
+				continue;
+			}
+			transfer_entry_t &next_entry = row[next];
+			if(  weight < next_entry.weight  ||  (weight == next_entry.weight  &&  current_entry.depth + 1 < next_entry.depth)  ) {
+				next_entry.weight = weight;
+				next_entry.first  = current == start ? next : current_entry.first;
+				next_entry.last   = current;
+				next_entry.depth  = current_entry.depth + 1;
+				open.insert( node_t(next, weight) );
+			}
+		}
+	}
+}
+
+
+const haltestelle_t::transfer_table_t *haltestelle_t::get_transfer_table(halthandle_t halt, uint8 catg_idx)
+{
+	const link_t &link = halt->all_links[catg_idx];
+	if(  link.catg_connected_component == UNDECIDED_CONNECTED_COMPONENT  ) {
+		return NULL;
+	}
+	const transfer_table_t *table = transfer_table_of.get( transfer_table_key( catg_idx, link.catg_connected_component ) );
+	if(  table == NULL  ||  !table->is_complete()  ||  link.transfer_index >= table->halts.get_count()  ||  table->halts[link.transfer_index] != halt  ) {
+		return NULL;
+	}
+	return table;
+}
+
+
+int haltestelle_t::search_transfer_tables( const halthandle_t *const start_halts, const uint16 start_halt_count, const vector_tpl<halthandle_t> &end_halts, ware_t &ware, ware_t *const return_ware )
+{
+	if(  transfer_tables_done == 0  ) {
+		return -1;
+	}
+	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
+	uint16 const max_transfers = welt->get_settings().get_max_transfers();
+
+	const transfer_table_t *best_table = NULL;
+	const transfer_entry_t *best_entry = NULL;
+	halthandle_t best_start, best_end;
+
+	for(  uint16 s = 0;  s < start_halt_count;  s++  ) {
+		halthandle_t const start_halt = start_halts[s];
+		const link_t &start_link = start_halt->all_links[ware_catg_idx];
+		if(  start_link.connections.empty()  ) {
+			// nothing reachable from here
+			continue;
+		}
+		const transfer_table_t *table = get_transfer_table( start_halt, ware_catg_idx );
+		if(  table == NULL  ) {
+			return -1;
+		}
+		const transfer_entry_t *const row = table->entries + start_link.transfer_index * table->halts.get_count();
+
+		FOR(vector_tpl<halthandle_t>, const end_halt, end_halts) {
+			const link_t &end_link = end_halt->all_links[ware_catg_idx];
+			if(  end_link.connections.empty()  ) {
+				continue;
+			}
+			if(  end_link.catg_connected_component != start_link.catg_connected_component  ) {
+				if(  end_link.catg_connected_component == UNDECIDED_CONNECTED_COMPONENT  ) {
+					return -1;
+				}
+				// other network
+				continue;
+			}
+			if(  end_link.transfer_index >= table->halts.get_count()  ||  table->halts[end_link.transfer_index] != end_halt  ) {
+				return -1;
+			}
+			const transfer_entry_t &entry = row[end_link.transfer_index];
+			if(  entry.weight == 0xffff  ) {
+				continue;
+			}
+			if(  entry.depth > max_transfers + 1  ) {
+				// a longer route with less transfers may exist => let the search decide
+				return -1;
+			}
+			if(  best_entry == NULL  ||  entry.weight < best_entry->weight  ) {
+				best_table = table;
+				best_entry = &entry;
+				best_start = start_halt;
+				best_end = end_halt;
+			}
+		}
+	}
+
+	if(  best_entry == NULL  ) {
+		ware.set_ziel( halthandle_t() );
+		ware.set_zwischenziel( halthandle_t() );
+		if(  return_ware  ) {
+			return_ware->set_ziel( halthandle_t() );
+			return_ware->set_zwischenziel( halthandle_t() );
+		}
+		return NO_ROUTE;
+	}
+
+	ware.set_ziel( best_end );
+	ware.set_zwischenziel( best_table->halts[best_entry->first] );
+	if(  return_ware  ) {
+		// same as in search_route(): next transfer only if unambiguous
+		halthandle_t const transfer = best_table->halts[best_entry->last];
+		uint8 t = best_end->is_transfer(ware_catg_idx);
+		FOR(vector_tpl<connection_t>, const& i, best_end->all_links[ware_catg_idx].connections) {
+			if (t > 1) {
+				break;
+			}
+			t += i.halt.is_bound() && i.is_transfer;
+		}
+		return_ware->set_ziel( best_start );
+		return_ware->set_zwischenziel( t<=1 ? transfer : halthandle_t() );
+	}
+	return ROUTE_OK;
+}
+
 /**
  * This routine tries to find a route for a good packet (ware)
  * it will be called for
@@ -1517,8 +2253,15 @@ uint8 haltestelle_t::last_search_ware_catg_idx = 255;
  * if USE_ROUTE_SLIST_TPL is defined, the list template will be used.
  * However, this is about 50% slower.
  */
-int haltestelle_t::search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware )
+int haltestelle_t::search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware, route_search_memory_t *memory )
 {
+	route_search_memory_t &mem = memory ? *memory : main_search_memory;
+	mem.reserve();
+	halt_data_t *const halt_data = mem.halt_data;
+	bucket_heap_tpl<route_node_t> &open_list = mem.open_list;
+	uint8 *const markers = mem.markers;
+	uint8 &current_marker = mem.current_marker;
+
 	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
 	const uint8 ware_idx = ware.get_desc()->get_index();
 
@@ -1526,11 +2269,11 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 	const planquadrat_t *const plan = welt->access( ware.get_zielpos() );
 	const halthandle_t *const halt_list = plan->get_haltlist();
 	// but we can only use a subset of these
-	static vector_tpl<halthandle_t> end_halts(16);
+	vector_tpl<halthandle_t> &end_halts = mem.end_halts;
 	end_halts.clear();
 	// target halts are in these connected components
 	// we start from halts only in the same components
-	static vector_tpl<uint16> end_conn_comp(16);
+	vector_tpl<quickstone_id_t> &end_conn_comp = mem.end_conn_comp;
 	end_conn_comp.clear();
 	// if one target halt is undefined, we have to start search from all halts
 	bool end_conn_comp_undefined = false;
@@ -1554,7 +2297,7 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 			end_halts.append(halt);
 
 			// check connected component of target halt
-			uint16 endhalt_conn_comp = halt->all_links[ware_catg_idx].catg_connected_component;
+			quickstone_id_t endhalt_conn_comp = halt->all_links[ware_catg_idx].catg_connected_component;
 			if (endhalt_conn_comp == UNDECIDED_CONNECTED_COMPONENT) {
 				// undefined: all start halts are probably connected to this target
 				end_conn_comp_undefined = true;
@@ -1578,8 +2321,19 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 		}
 		return NO_ROUTE;
 	}
-	// invalidate search history
-	last_search_origin = halthandle_t();
+
+	if(  !no_routing_over_overcrowding  ) {
+		// overcrowding changes all the time and is not in the tables
+		const int result = search_transfer_tables( start_halts, start_halt_count, end_halts, ware, return_ware );
+		if(  result >= 0  ) {
+			return result;
+		}
+	}
+
+	if(  &mem == &main_search_memory  ) {
+		// invalidate search history
+		last_search_origin = halthandle_t();
+	}
 
 	// set current marker
 	++current_marker;
@@ -1590,7 +2344,7 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 
 	// initialisations for end halts => save some checking inside search loop
 	FOR(vector_tpl<halthandle_t>, const e, end_halts) {
-		uint16 const halt_id = e.get_id();
+		quickstone_id_t const halt_id = e.get_id();
 		halt_data[ halt_id ].best_weight = 65535u;
 		halt_data[ halt_id ].destination = 1u;
 		halt_data[ halt_id ].depth       = 1u; // to distinct them from start halts
@@ -1609,7 +2363,7 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 	for(  ;  allocation_pointer<start_halt_count;  ++allocation_pointer  ) {
 		halthandle_t start_halt = start_halts[allocation_pointer];
 
-		uint16 start_conn_comp = start_halt->all_links[ware_catg_idx].catg_connected_component;
+		quickstone_id_t start_conn_comp = start_halt->all_links[ware_catg_idx].catg_connected_component;
 
 		if (!end_conn_comp_undefined   &&  start_conn_comp != UNDECIDED_CONNECTED_COMPONENT  &&  !end_conn_comp.is_contained( start_conn_comp  )){
 			// this start halt will not lead to any target
@@ -1640,7 +2394,7 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 		// do not use aggregate_weight as it is _not_ the weight of the current_node
 		// there might be a heuristic weight added
 
-		const uint16 current_halt_id = current_node.halt.get_id();
+		const quickstone_id_t current_halt_id = current_node.halt.get_id();
 		halt_data_t & current_halt_data = halt_data[ current_halt_id ];
 		overcrowded_nodes -= current_halt_data.overcrowded;
 
@@ -1699,7 +2453,7 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 
 			// since these are pre-calculated, they should be always pointing to a valid ground
 			// (if not, we were just under construction, and will be fine after 16 steps)
-			const uint16 reachable_halt_id = current_conn.halt.get_id();
+			const quickstone_id_t reachable_halt_id = current_conn.halt.get_id();
 
 			if(  markers[ reachable_halt_id ]!=current_marker  ) {
 				// Case : not processed before
@@ -1785,6 +2539,12 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 
 void haltestelle_t::search_route_resumable(  ware_t &ware   )
 {
+	main_search_memory.reserve();
+	halt_data_t *const halt_data = main_search_memory.halt_data;
+	bucket_heap_tpl<route_node_t> &open_list = main_search_memory.open_list;
+	uint8 *const markers = main_search_memory.markers;
+	uint8 &current_marker = main_search_memory.current_marker;
+
 	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
 
 	// continue search if start halt and good category did not change
@@ -1803,7 +2563,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 	}
 
 	// remember destination nodes, to reset them before returning
-	static vector_tpl<uint16> dest_indices(16);
+	static vector_tpl<quickstone_id_t> dest_indices(16);
 	dest_indices.clear();
 
 	uint16 best_destination_weight = 65535u;
@@ -1845,7 +2605,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 		}
 	}
 	// we start in this connected component
-	uint16 const conn_comp = all_links[ ware_catg_idx ].catg_connected_component;
+	quickstone_id_t const conn_comp = all_links[ ware_catg_idx ].catg_connected_component;
 
 	// find suitable destination halt(s), if any
 	for( uint8 h=0;  h<plan->get_haltlist_count();  ++h  ) {
@@ -1853,7 +2613,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 		if(  halt.is_bound()  &&  halt->is_enabled(ware_catg_idx)  ) {
 
 			// test for connected component
-			uint16 const dest_comp = halt->all_links[ ware_catg_idx ].catg_connected_component;
+			quickstone_id_t const dest_comp = halt->all_links[ ware_catg_idx ].catg_connected_component;
 			if (dest_comp != UNDECIDED_CONNECTED_COMPONENT  &&  conn_comp != UNDECIDED_CONNECTED_COMPONENT  &&  conn_comp != dest_comp) {
 				continue;
 			}
@@ -1905,7 +2665,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 
 		route_node_t current_node = open_list.pop();
 
-		const uint16 current_halt_id = current_node.halt.get_id();
+		const quickstone_id_t current_halt_id = current_node.halt.get_id();
 		const uint16 current_weight = current_node.aggregate_weight;
 		halt_data_t & current_halt_data = halt_data[ current_halt_id ];
 
@@ -1946,7 +2706,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 		}
 
 		FOR(vector_tpl<connection_t>, const& current_conn, current_node.halt->all_links[ware_catg_idx].connections) {
-			const uint16 reachable_halt_id = current_conn.halt.get_id();
+			const quickstone_id_t reachable_halt_id = current_conn.halt.get_id();
 
 			const uint16 total_weight = current_weight + current_conn.weight;
 
@@ -1994,7 +2754,7 @@ void haltestelle_t::search_route_resumable(  ware_t &ware   )
 	}
 
 	// clear destinations since we may want to do another search with the same current_marker
-	FOR(vector_tpl<uint16>, const i, dest_indices) {
+	FOR(vector_tpl<quickstone_id_t>, const i, dest_indices) {
 		halt_data[i].destination = false;
 		if (halt_data[i].best_weight == 65535u) {
 			// not processed -> reset marker
@@ -2058,9 +2818,10 @@ void haltestelle_t::liefere_an_fabrik(const ware_t& ware) const
 bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 {
 	w.menge = 0;
-	slist_tpl<ware_t> *warray = cargo[w.get_desc()->get_catg_index()];
+	freight_store_t *warray = cargo[w.get_desc()->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(slist_tpl<ware_t>, & tmp, *warray) {
+		for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+			ware_t &tmp = (*warray)[pos];
 			// skip empty entries
 			if(tmp.menge==0  ||  w.get_index()!=tmp.get_index()  ||  w.get_zielpos()!=tmp.get_zielpos()) {
 				continue;
@@ -2075,7 +2836,7 @@ bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 			else {
 				// leave an empty entry => joining will more often work
 				w.menge = tmp.menge;
-				tmp.menge = 0;
+				warray->remove(pos);
 			}
 			book(w.menge, HALT_ARRIVED);
 			fabrik_t::update_transit( &w, false );
@@ -2088,111 +2849,113 @@ bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 }
 
 
-void haltestelle_t::fetch_goods_nearest_first( slist_tpl<ware_t> &load, slist_tpl<ware_t> *wares, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts) {
-	// first iterate over the next stop, then over the ware
-	// might be a little slower, but ensures that passengers to nearest stop are served first
-	// this allows for separate high speed and normal service
-	for(  uint32 i=0; i < destination_halts.get_count();  i++  ) {
-		halthandle_t plan_halt = destination_halts[i];
-
-		// REMOVED: The random offset will ensure that all goods have an equal chance to be loaded.
-		for(  slist_tpl<ware_t>::iterator tmp = wares->begin();  tmp!=wares->end();  tmp++) {
-			// skip empty entries
-			if(tmp->menge==0) {
-				continue;
-			}
-
-			// goods without route -> returning passengers/mail
-			if(  !tmp->get_zwischenziel().is_bound()  ) {
-				search_route_resumable(*tmp);
-				if (!tmp->get_ziel().is_bound()) {
-					// no route anymore
-					tmp->menge = 0;
-					continue;
-				}
-			}
-
-			// compatible car and right target stop?
-			if(  tmp->get_zwischenziel()==plan_halt  ) {
-				if(  plan_halt->is_overcrowded( tmp->get_index() )  ) {
-					if (welt->get_settings().is_avoid_overcrowding() && tmp->get_ziel() != plan_halt) {
-						// do not go for transfer to overcrowded transfer stop
-						continue;
-					}
-				}
+void haltestelle_t::route_returning_goods(freight_store_t *wares)
+{
+	// goods without route -> returning passengers/mail
+	const vector_tpl<uint32> *returning = wares->get_via( halthandle_t() );
+	if(  returning==NULL  ||  returning->empty()  ) {
+		return;
+	}
+	for(  uint32 i=0;  i < returning->get_count();  i++  ) {
+		const uint32 pos = (*returning)[i];
+		ware_t &ware = (*wares)[pos];
+		if(  ware.menge==0  ||  ware.get_zwischenziel().is_bound()  ) {
+			continue;
+		}
+		search_route_resumable(ware);
+		if(  !ware.get_ziel().is_bound()  ) {
+			// no route anymore
+			wares->remove(pos);
+			continue;
+		}
+		wares->update(pos);
+	}
+	wares->prune_via( halthandle_t() );
+}
 
-				// not too much?
-				ware_t neu(*tmp);
-				if(  tmp->menge > requested_amount  ) {
-					// not all can be loaded
-					neu.menge = requested_amount;
-					tmp->menge -= requested_amount;
-					requested_amount = 0;
-				}
-				else {
-					requested_amount -= tmp->menge;
-					// leave an empty entry => joining will more often work
-					tmp->menge = 0;
-				}
-				load.insert(neu);
 
-				book(neu.menge, HALT_DEPARTED);
-				resort_freight_info = true;
+void haltestelle_t::plan_loading( loading_plan_t::category_t &planned, freight_store_t *wares, const vector_tpl<halthandle_t>& destination_halts)
+{
+	route_returning_goods(wares);
 
-				if (requested_amount==0) {
-					return;
+	// first iterate over the next stop, then over the ware
+	// ensures that passengers to nearest stop are served first
+	// this allows for separate high speed and normal service
+	for(  uint32 i=0;  i < destination_halts.get_count();  i++  ) {
+		const halthandle_t plan_halt = destination_halts[i];
+		if(  destination_halts.index_of(plan_halt) != i  ) {
+			// halt visited twice
+			continue;
+		}
+		const vector_tpl<uint32> *via = wares->get_via(plan_halt);
+		if(  via  ) {
+			FOR(vector_tpl<uint32>, const pos, *via) {
+				// skip empty entries and goods, which go elsewhere meanwhile
+				if(  (*wares)[pos].menge>0  &&  (*wares)[pos].get_zwischenziel()==plan_halt  ) {
+					loading_plan_t::entry_t entry;
+					entry.pos = pos;
+					entry.via = plan_halt;
+					planned.entries.append(entry);
 				}
 			}
 		}
+	}
 
-		// nothing there to load
+	if(  welt->get_settings().get_first_come_first_serve()  ) {
+		// in order of arrival for all stops
+		std::sort( planned.entries.begin(), planned.entries.end(), loading_plan_t::entry_t::compare );
 	}
 }
 
 
-void haltestelle_t::fetch_goods_FIFO( slist_tpl<ware_t> &load, slist_tpl<ware_t> *wares, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts) {
-	for(  slist_tpl<ware_t>::iterator ware = wares->begin();  ware!=wares->end();  ) {
-		// empty entry -> remove
-		if(ware->menge==0) {
-			ware = wares->erase(ware);
-			continue;
-		}
+void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *good_category, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts, loading_plan_t &plan)
+{
+	const uint8 catg_index = good_category->get_catg_index();
+	freight_store_t *warray = cargo[catg_index];
+	if(  !warray  ||  warray->empty()  ) {
+		return;
+	}
 
-		// goods without route -> returning passengers/mail
-		if(  !ware->get_zwischenziel().is_bound()  ) {
-			search_route_resumable(*ware);
-			if (!ware->get_ziel().is_bound()) {
-				// no route anymore
-				ware = wares->erase(ware);
-				continue;
-			}
-		}
+	while(  plan.categories.get_count() <= catg_index  ) {
+		plan.categories.append( NULL );
+	}
+	loading_plan_t::category_t *planned = plan.categories[catg_index];
+	if(  planned==NULL  ) {
+		planned = new loading_plan_t::category_t();
+		plan.categories[catg_index] = planned;
+		plan_loading( *planned, warray, destination_halts );
+	}
+
+	const bool avoid_overcrowding = welt->get_settings().is_avoid_overcrowding();
+	for(  uint32 i = planned->next;  i < planned->entries.get_count();  i++  ) {
+		const loading_plan_t::entry_t &entry = planned->entries[i];
+		ware_t &tmp = (*warray)[entry.pos];
 
-		// right target stop, and not overcrowding?
-		// do not go for transfer to overcrowded transfer stop
-		if(
-			!destination_halts.is_contained(ware->get_zwischenziel())  ||
-			(welt->get_settings().is_avoid_overcrowding()  &&
-				ware->get_zwischenziel()->is_overcrowded( ware->get_index() )  &&
-				ware->get_ziel() != ware->get_zwischenziel())
+		// used up, rerouted, or transfer to overcrowded transfer stop => skip for all vehicles
+		if(  tmp.menge==0  ||  tmp.get_zwischenziel()!=entry.via  ||
+			(avoid_overcrowding  &&  tmp.get_ziel()!=entry.via  &&  entry.via->is_overcrowded( tmp.get_index() ))
 		) {
-			ware++;
+			if(  i==planned->next  ) {
+				planned->next++;
+			}
 			continue;
 		}
 
 		// not too much?
-		ware_t neu(*ware);
-		if(  ware->menge > requested_amount  ) {
+		ware_t neu(tmp);
+		if(  tmp.menge > requested_amount  ) {
 			// not all can be loaded
 			neu.menge = requested_amount;
-			ware->menge -= requested_amount;
+			tmp.menge -= requested_amount;
 			requested_amount = 0;
 		}
 		else {
-			requested_amount -= ware->menge;
+			requested_amount -= tmp.menge;
 			// leave an empty entry => joining will more often work
-			ware->menge = 0;
-			ware = wares->erase(ware);
+			warray->remove(entry.pos);
+			if(  i==planned->next  ) {
+				planned->next++;
+			}
 		}
 		load.insert(neu);
 
@@ -2206,16 +2969,12 @@ void haltestelle_t::fetch_goods_FIFO( slist_tpl<ware_t> &load, slist_tpl<ware_t>
 }
 
 
-void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *good_category, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts)
+void haltestelle_t::end_loading()
 {
-	slist_tpl<ware_t> *warray = cargo[good_category->get_catg_index()];
-	if(  !warray  ||  warray->empty()  ) {
-		return;
-	}
-	if(  world()->get_settings().get_first_come_first_serve()  ) {
-		fetch_goods_FIFO(load, warray, requested_amount, destination_halts);
-	} else {
-		fetch_goods_nearest_first(load, warray, requested_amount, destination_halts);
+	for(  uint8 i=0;  i<goods_manager_t::get_max_catg_index();  i++  ) {
+		if(  cargo[i]  &&  cargo[i]->needs_compaction()  ) {
+			cargo[i]->compact();
+		}
 	}
 }
 
@@ -2223,9 +2982,10 @@ void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *go
 uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
 {
 	int sum = 0;
-	const slist_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
+	const freight_store_t * warray = cargo[wtyp->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(slist_tpl<ware_t>, const& i, *warray) {
+		for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+			const ware_t &i = (*warray)[pos];
 			if (wtyp->get_index() == i.get_index()) {
 				sum += i.menge;
 			}
@@ -2237,12 +2997,11 @@ uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
 
 uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koord zielpos) const
 {
-	const slist_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
+	const freight_store_t * warray = cargo[wtyp->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(slist_tpl<ware_t>, const& ware, *warray) {
-			if(wtyp->get_index()==ware.get_index()  &&  ware.get_zielpos()==zielpos) {
-				return ware.menge;
-			}
+		const uint32 pos = warray->find_zielpos( wtyp->get_index(), zielpos );
+		if(  pos!=freight_store_t::NO_PACKET  ) {
+			return (*warray)[pos].menge;
 		}
 	}
 	return 0;
@@ -2252,9 +3011,11 @@ uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koor
 uint32 haltestelle_t::get_ware_fuer_zwischenziel(const goods_desc_t *wtyp, const halthandle_t zwischenziel) const
 {
 	uint32 sum = 0;
-	const slist_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		FOR(slist_tpl<ware_t>, const& ware, *warray) {
+	const freight_store_t * warray = cargo[wtyp->get_catg_index()];
+	const vector_tpl<uint32> *via = warray ? warray->get_via(zwischenziel) : NULL;
+	if(via!=NULL) {
+		FOR(vector_tpl<uint32>, const pos, *via) {
+			const ware_t &ware = (*warray)[pos];
 			if(wtyp->get_index()==ware.get_index()  &&  ware.get_zwischenziel()==zwischenziel) {
 				sum += ware.menge;
 			}
@@ -2274,23 +3035,24 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware)
 	}
 
 	// pruefen ob die ware mit bereits wartender ware vereinigt werden kann
-	slist_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
+	freight_store_t * warray = cargo[ware.get_desc()->get_catg_index()];
 	if(  !warray  ) {
 		return false;
 	}
-	FOR(slist_tpl<ware_t>, & tmp, *warray) {
-		// join packets with same destination
-		if(ware.same_destination(tmp)) {
-			if(  ware.get_zwischenziel().is_bound()  &&  ware.get_zwischenziel()!=self  ) {
-				// update route if there is newer route
-				tmp.set_zwischenziel( ware.get_zwischenziel() );
-			}
-			tmp.menge += ware.menge;
-			resort_freight_info = true;
-			return true;
-		}
+	// join packets with same destination
+	const uint32 pos = warray->find_same_destination(ware);
+	if(  pos==freight_store_t::NO_PACKET  ) {
+		return false;
 	}
-	return false;
+	ware_t &tmp = (*warray)[pos];
+	if(  ware.get_zwischenziel().is_bound()  &&  ware.get_zwischenziel()!=self  &&  ware.get_zwischenziel()!=tmp.get_zwischenziel()  ) {
+		// update route if there is newer route
+		tmp.set_zwischenziel( ware.get_zwischenziel() );
+		warray->update(pos);
+	}
+	tmp.menge += ware.menge;
+	resort_freight_info = true;
+	return true;
 }
 
 
@@ -2300,10 +3062,10 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware)
 void haltestelle_t::add_ware_to_halt(ware_t ware)
 {
 	// now we have to add the ware to the stop
-	slist_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
+	freight_store_t * warray = cargo[ware.get_desc()->get_catg_index()];
 	if(warray==NULL) {
 		// this type was not stored here before ...
-		warray = new slist_tpl<ware_t>();
+		warray = new freight_store_t();
 		cargo[ware.get_desc()->get_catg_index()] = warray;
 	}
 	resort_freight_info = true;
@@ -2421,8 +3183,8 @@ void haltestelle_t::get_freight_info(cbuffer_t & buf)
 				continue;
 			}
 			vector_tpl<ware_t> wvector;
-			FOR(slist_tpl<ware_t>, & w, *cargo[i]) {
-				wvector.append(w);
+			for(  uint32 pos = 0;  pos < cargo[i]->get_count();  pos++  ) {
+				wvector.append( (*cargo[i])[pos] );
 			}
 			freight_list_sorter_t::sort_freight(wvector, buf, (freight_list_sorter_t::sort_mode_t)sortierung, NULL, "waiting");
 		}
@@ -2751,10 +3513,12 @@ void haltestelle_t::transfer_goods(halthandle_t halt)
 	}
 	// transfer goods to halt
 	for(uint8 i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-		const slist_tpl<ware_t> * warray = cargo[i];
+		const freight_store_t * warray = cargo[i];
 		if (warray) {
-			FOR(slist_tpl<ware_t>, const& j, *warray) {
-				halt->add_ware_to_halt(j);
+			for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+				if(  (*warray)[pos].menge>0  ) {
+					halt->add_ware_to_halt( (*warray)[pos] );
+				}
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
@@ -2920,14 +3684,14 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	// will restore halthandle_t after loading
 	if(file->is_version_atleast(110, 6)) {
 		if(file->is_saving()) {
-			uint16 halt_id = self.is_bound() ? self.get_id() : 0;
-			file->rdwr_short(halt_id);
+			uint32 halt_id = self.is_bound() ? self.get_id() : 0;
+			file->rdwr_handle_id(halt_id);
 		}
 		else {
-			uint16 halt_id;
-			file->rdwr_short(halt_id);
+			uint32 halt_id;
+			file->rdwr_handle_id(halt_id);
 			self.set_id(halt_id);
-			self = halthandle_t(this, halt_id);
+			self = halthandle_t(this, (quickstone_id_t)halt_id);
 		}
 	}
 	else {
@@ -2993,7 +3757,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	if(file->is_saving()) {
 		const char *s;
 		for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-			slist_tpl<ware_t> *warray = cargo[i];
+			freight_store_t *warray = cargo[i];
 			if(warray) {
 				s = "y"; // needs to be non-empty
 				file->rdwr_str(s);
@@ -3005,8 +3769,8 @@ void haltestelle_t::rdwr(loadsave_t *file)
 					uint32 count = warray->get_count();
 					file->rdwr_long(count);
 				}
-				FOR(slist_tpl<ware_t>, & ware, *warray) {
-					ware.rdwr(file);
+				for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+					(*warray)[pos].rdwr(file);
 				}
 			}
 		}
@@ -3080,17 +3844,28 @@ void haltestelle_t::rdwr(loadsave_t *file)
 		}
 	}
 
-	// read and write departure slots.
+	// read and write departure slots, grouped by dep_tick % DST_SIZE
 	if(  file->get_OTRP_version()>=24  ) {
+		if(  file->is_loading()  ) {
+			departure_slots.clear();
+		}
 		for(uint8 idx=0; idx<DST_SIZE; idx++) {
-			uint32 n = departure_slot_table[idx].get_count();
-			file->rdwr_long(n);
-			slist_tpl<departure_t>::iterator i = departure_slot_table[idx].begin();
-			if(  file->is_loading()  ) {
-				departure_slot_table[idx].clear();
+			uint32 n = 0;
+			if(  file->is_saving()  ) {
+				FOR(vector_tpl<departure_t>, const& d, departure_slots) {
+					n += d.dep_tick % DST_SIZE == idx;
+				}
 			}
-			for(uint8 k=0; k<n; k++) {
-				departure_t d = file->is_loading() ? departure_t() : *i;
+			file->rdwr_long(n);
+			uint32 pos = 0;
+			for(uint32 k=0; k<n; k++) {
+				departure_t d;
+				if(  file->is_saving()  ) {
+					while(  departure_slots[pos].dep_tick % DST_SIZE != idx  ) {
+						pos++;
+					}
+					d = departure_slots[pos++];
+				}
 				file->rdwr_long(d.arr_tick);
 				file->rdwr_long(d.dep_tick);
 				file->rdwr_long(d.exp_tick);
@@ -3101,9 +3876,11 @@ void haltestelle_t::rdwr(loadsave_t *file)
 				}
 				convoi_t::rdwr_convoihandle_t(file, d.cnv);
 				if(  file->is_loading()  ) {
-					departure_slot_table[idx].append(d);
-				} else {
-					i++; // increment iterator
+					uint32 at = find_departure(d.dep_tick);
+					while(  at<departure_slots.get_count()  &&  departure_slots[at].dep_tick==d.dep_tick  ) {
+						at++;
+					}
+					departure_slots.insert_at( at, d );
 				}
 			}
 		}
@@ -3121,10 +3898,12 @@ void haltestelle_t::finish_rd()
 	// fix good destination coordinates
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if(cargo[i]) {
-			slist_tpl<ware_t> * warray = cargo[i];
-			FOR(slist_tpl<ware_t>, & j, *warray) {
-				j.finish_rd(welt);
+			freight_store_t * warray = cargo[i];
+			for(  uint32 pos = 0;  pos < warray->get_count();  pos++  ) {
+				(*warray)[pos].finish_rd(welt);
 			}
+			// the targets are known only now
+			warray->rebuild();
 		}
 	}
 
@@ -3814,59 +4593,84 @@ bool haltestelle_t::is_halt_covered(const halthandle_t &halt) const
 }
 
 
+uint32 haltestelle_t::find_departure(uint32 dep_tick) const {
+	uint32 lo = 0, hi = departure_slots.get_count();
+	while(  lo < hi  ) {
+		const uint32 mid = (lo + hi) / 2;
+		if(  departure_slots[mid].dep_tick < dep_tick  ) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+
+bool haltestelle_t::is_departure_valid(const departure_t &dep) const {
+	return welt->get_ticks()<=dep.exp_tick  &&  dep.cnv.is_bound();
+}
+
+
 bool haltestelle_t::book_departure (uint32 arr_tick, uint32 dep_tick, uint32 exp_tick, convoihandle_t cnv) {
-	const uint8 idx = dep_tick % DST_SIZE;
-	slist_tpl<departure_t>::iterator i = departure_slot_table[idx].begin();
+	// remove the obsolete slots in the past
+	uint32 obsolete = 0;
+	while(  obsolete<departure_slots.get_count()  &&  !is_departure_valid(departure_slots[obsolete])  ) {
+		obsolete++;
+	}
+	if(  obsolete>0  ) {
+		for(  uint32 i=obsolete;  i<departure_slots.get_count();  i++  ) {
+			departure_slots[i-obsolete] = departure_slots[i];
+		}
+		while(  obsolete-->0  ) {
+			departure_slots.pop_back();
+		}
+	}
+
 	const uint8 stop_index = cnv->get_schedule()->get_current_stop_exluding_depot();
-	while(  i!=departure_slot_table[idx].end()  ) {
-		if(  welt->get_ticks()>i->exp_tick  ||  !i->cnv.is_bound()  ) {
-			// This entry is already obsolete. Just remove it.
-			i = departure_slot_table[idx].erase(i);
+	uint32 i = find_departure(dep_tick);
+	for(  ;  i<departure_slots.get_count()  &&  departure_slots[i].dep_tick==dep_tick;  i++  ) {
+		const departure_t &d = departure_slots[i];
+		if(  !is_departure_valid(d)  ) {
 			continue;
 		}
-		if(  i->cnv==cnv  &&  i->arr_tick==arr_tick  ) {
+		if(  d.cnv==cnv  &&  d.arr_tick==arr_tick  ) {
 			// The requested slot is already reserved by this convoy.
 			return true;
 		} else if(
-			i->dep_tick==dep_tick  &&
-			(i->cnv==cnv  ||  i->cnv->get_line()==cnv->get_line())  &&
-			i->stop_index==stop_index
+			(d.cnv==cnv  ||  d.cnv->get_line()==cnv->get_line())  &&
+			d.stop_index==stop_index
 		) {
 			// The slot is already reserved by other convoy.
 			return false;
 		}
-		i++;
 	}
-	// reserve the slot.
+	// reserve the slot after the others of this tick.
 	departure_t dep(arr_tick, dep_tick, exp_tick, stop_index, cnv);
-	departure_slot_table[idx].insert(departure_slot_table[idx].begin(), dep);
+	departure_slots.insert_at(i, dep);
 	return true;
 }
 
 
 bool haltestelle_t::erase_departure(uint32 dep_tick, convoihandle_t cnv) {
-	const uint8 idx = dep_tick % DST_SIZE;
-	slist_tpl<departure_t>::iterator i = departure_slot_table[idx].begin();
 	// find and remove the requested departure slot
-	while(  i!=departure_slot_table[idx].end()  ) {
-		if(  i->cnv==cnv  &&  i->dep_tick==dep_tick  ) {
-			departure_slot_table[idx].erase(i);
+	for(  uint32 i = find_departure(dep_tick);  i<departure_slots.get_count()  &&  departure_slots[i].dep_tick==dep_tick;  i++  ) {
+		if(  departure_slots[i].cnv==cnv  ) {
+			departure_slots.remove_at(i);
 			return true;
 		}
-		i++;
 	}
 	return false; // we cannot find the requested departure slot.
 }
 
 
 bool haltestelle_t::is_departure_booked(uint32 dep_tick, uint8 stop_index, linehandle_t line) const {
-	const uint8 idx = dep_tick % DST_SIZE;
-	slist_tpl<departure_t>::const_iterator i = departure_slot_table[idx].begin();
-	while(  i!=departure_slot_table[idx].end()  ) {
-		if(  i->dep_tick==dep_tick  &&  i->stop_index==stop_index  &&  i->cnv->get_line()==line  ) {
+	for(  uint32 i = find_departure(dep_tick);  i<departure_slots.get_count()  &&  departure_slots[i].dep_tick==dep_tick;  i++  ) {
+		const departure_t &d = departure_slots[i];
+		if(  d.stop_index==stop_index  &&  d.cnv.is_bound()  &&  d.cnv->get_line()==line  ) {
 			return true;
 		}
-		i++;
 	}
 	return false;
 }
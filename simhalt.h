@@ -20,6 +20,7 @@
 #include "descriptor/goods_desc.h"
 
 #include "dataobj/koord.h"
+#include "dataobj/loading_plan.h"
 
 #include "tpl/inthashtable_tpl.h"
 
@@ -42,11 +43,12 @@
 #define HALT_CONVOIS_ARRIVED 6 // number of convois arrived this month
 #define HALT_WALKED          7 // could walk to destination
 
-#define DST_SIZE 101 // size of departure_slot_table
+#define DST_SIZE 101 // departure slots are saved in this many buckets of dep_tick
 
 class cbuffer_t;
 class grund_t;
 class fabrik_t;
+class freight_store_t;
 class karte_t;
 class karte_ptr_t;
 class koord3d;
@@ -122,6 +124,35 @@ private:
 
 	static uint8 status_step; // NONE or SCHEDULING or REROUTING
 
+	/// halts served by changed schedules, reconnected in the next round of step_all()
+	static vector_tpl<halthandle_t> dirty_halts;
+
+	/// the halts of the current round of step_all(), if not all are handled
+	static vector_tpl<halthandle_t> partial_halts;
+	static bool partial_step;
+
+	/// packets rerouted in each step_all() and the next halt to reroute
+	static sint32 reroute_budget;
+	static uint32 reroute_index;
+
+	/// sets the rerouting budget for a new round
+	static void start_rerouting(const vector_tpl<halthandle_t> &halts);
+
+	/// reroutes the goods of @p halts starting at @p index, returns true when finished
+	static bool reroute_halts(const vector_tpl<halthandle_t> &halts, uint32 &index);
+
+	/// true while in dirty_halts
+	bool connections_dirty;
+
+	static void forget_dirty_halts();
+
+	/**
+	 * Replaces @p halts by all halts in the same connected components
+	 * (of any category) as them, i.e. those whose goods may take other routes now.
+	 * The halts of @p halts come first.
+	 */
+	static void collect_rerouted_halts(vector_tpl<halthandle_t> &halts);
+
 	vector_tpl<convoihandle_t> loading_here;
 	sint32 last_loading_step;
 
@@ -158,6 +189,17 @@ public:
 	 */
 	static void reset_routing();
 
+	/**
+	 * The schedules serving this halt have changed: the next call to step_all() rebuilds its connections
+	 * and reroutes the goods in its network, without reconnecting all other halts.
+	 */
+	void set_connections_dirty();
+
+	/**
+	 * Calls set_connections_dirty() for all stops of @p schedule.
+	 */
+	static void set_connections_dirty(const schedule_t *schedule, const player_t *owner);
+
 	/**
 	 * Tries to generate some pedestrians on the square and the
 	 * adjacent squares. Return actual number of generated
@@ -271,9 +313,13 @@ private:
 		 * The id of the component has to be equal to the halt-id of one of its halts.
 		 * This ensures that we always have unique component ids.
 		 */
-		uint16 catg_connected_component;
+		quickstone_id_t catg_connected_component;
+
+		// never a valid halt index
+#		define UNDECIDED_CONNECTED_COMPONENT (QUICKSTONE_MAX_ID)
 
-#		define UNDECIDED_CONNECTED_COMPONENT (0xffff)
+		/// index of this halt in the transfer table of its component (only valid while the table exists)
+		uint16 transfer_index;
 
 		link_t() { clear(); }
 
@@ -282,6 +328,7 @@ private:
 			connections.clear();
 			is_transfer = false;
 			catg_connected_component = UNDECIDED_CONNECTED_COMPONENT;
+			transfer_index = 0xffff;
 		}
 	};
 
@@ -290,22 +337,40 @@ private:
 
 	/**
 	 * Fills in catg_connected_component values for all halts and all categories.
-	 * Uses depth-first search.
+	 * Follows the connections iteratively, with a snapshot of the halts.
+	 * Also sets connection_t::is_transfer.
 	 */
 	static void rebuild_connected_components();
 
 	/**
-	 * Helper method: This halt (and all its connected neighbors) belong
-	 * to the same component.
-	 * Also sets connection_t::is_transfer.
-	 * @param catg category of cargo network
-	 * @param comp number of component
+	 * Like rebuild_connected_components(), but the components are computed in the background
+	 * (if multithreaded) and are set by the next wait_connected_components().
+	 * Until then they are undecided.
 	 */
-	void fill_connected_component(uint8 catg, uint16 comp);
+	static void start_connected_components();
+
+	/// sets the components computed since start_connected_components(), waits for them if needed
+	static void wait_connected_components();
+
+	/// takes a snapshot of the halts and sets connection_t::is_transfer
+	static void prepare_connected_components();
+
+	/**
+	 * Fills the components on the snapshot by a depth-first search with an explicit stack
+	 * along the directed connections. Does not touch anything else (may run in another thread).
+	 */
+	static void compute_connected_components();
+
+	static void apply_connected_components();
+
+	static void *connected_components_thread(void *);
+
+	/// true, while connected components are computed and transfer tables and rerouting still have to be planned
+	static bool finish_reconnecting;
 
 
 	// Array with different categories that contains all waiting goods at this stop
-	slist_tpl<ware_t> **cargo;
+	freight_store_t **cargo;
 
 	/**
 	 * Liste der angeschlossenen Fabriken
@@ -324,7 +389,7 @@ private:
 	void add_to_station_type( grund_t *gr );
 
 	/**
-	 * Reconnect and reroute if counter different from welt->get_schedule_counter()
+	 * Reconnect and reroute if counter different from welt->get_reconnect_all_counter()
 	 */
 	static uint8 reconnect_counter;
 	// since we do partial routing, we remember the last offset
@@ -352,9 +417,8 @@ private:
 	void transfer_goods(halthandle_t halt);
 	
 	
-	void fetch_goods_FIFO( slist_tpl<ware_t> &load, slist_tpl<ware_t> *wares, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts);
-	
-	void fetch_goods_nearest_first( slist_tpl<ware_t> &load, slist_tpl<ware_t> *wares, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts);
+	/// routes the goods waiting here without a next transfer halt (unbound zwischenziel)
+	void route_returning_goods(freight_store_t *wares);
 
 	/**
 	* parameter to ease sorting
@@ -373,7 +437,10 @@ public:
 	* will distribute the goods to changed routes (if there are any)
 	* returns true upon completion
 	*/
-	bool reroute_goods(sint16 &units_remaining);
+	bool reroute_goods(sint32 &units_remaining);
+
+	/// true, if @p halt is directly reachable from here for this category
+	bool is_linked(halthandle_t halt, uint8 catg_index) const;
 
 	/**
 	 * getter/setter for sortby
@@ -407,10 +474,24 @@ public:
 
 	void remove_fabriken(fabrik_t *fab);
 
+	/**
+	 * Temporary memory of rebuild_connections(), one per thread.
+	 */
+	struct reconnect_scratch_t {
+		// halts which either immediately precede or succeed self halt in serving schedules
+		vector_tpl<halthandle_t> consecutive_halts[256];
+		// halts which either immediately precede or succeed self halt in currently processed schedule
+		vector_tpl<halthandle_t> consecutive_halts_schedule[256];
+		// previous halt supporting the ware categories of the serving line
+		halthandle_t previous_halt[256];
+	};
+
 	/**
 	 * Rebuilds the list of connections to reachable halts
 	 * returns the search number of connections
+	 * Halts can be rebuilt in parallel with different @p scratch, then @p interruptible must be false.
 	 */
+	sint32 rebuild_connections(reconnect_scratch_t &scratch, bool interruptible = true);
 	sint32 rebuild_connections();
 
 	/**
@@ -457,7 +538,7 @@ public:
 	/**
 	 * called regularly to update status and reroute stuff
 	 */
-	bool step(uint8 what, sint16 &units_remaining);
+	bool step(uint8 what, sint32 &units_remaining);
 
 	/**
 	 * Called every month/every 24 game hours
@@ -494,23 +575,70 @@ private:
 		bool overcrowded:1;
 	};
 
-	// store the best weight so far for a halt, and indicate whether it is a destination
-	static halt_data_t halt_data[65536];
+	/**
+	 * Remember last route search start and catg to resume search
+	 */
+	static halthandle_t last_search_origin;
+	static uint8        last_search_ware_catg_idx;
 
-	// for efficient retrieval of the node with the smallest weight
-	static bucket_heap_tpl<route_node_t> open_list;
+	/// best route between two halts of a transfer table
+	struct transfer_entry_t
+	{
+		uint16 weight; ///< 0xffff: not reachable
+		uint16 first;  ///< index of the first halt after the start halt
+		uint16 last;   ///< index of the last halt before the target halt
+		uint16 depth;  ///< number of connections used
+	};
 
 	/**
-	 * Markers used in route searching to avoid processing the same halt more than once
+	 * Precomputed best routes between all halts of one connected component of a category.
+	 * Only exists while the connections are unchanged since rebuild_connected_components().
 	 */
-	static uint8 markers[65536];
-	static uint8 current_marker;
+	struct transfer_table_t
+	{
+		uint8 catg_idx;
+		vector_tpl<halthandle_t> halts;
+		/// halts.get_count() rows of halts.get_count() entries, one row per start halt
+		transfer_entry_t *entries;
+		/// number of rows calculated so far, table can be used if all rows are done
+		uint32 rows_done;
+
+		transfer_table_t(uint8 catg) : catg_idx(catg), entries(NULL), rows_done(0) {}
+		~transfer_table_t() { free( entries ); }
+
+		bool is_complete() const { return rows_done == halts.get_count(); }
+	};
+
+	/// all transfer tables in order of calculation
+	static vector_tpl<transfer_table_t *> transfer_tables;
+	/// transfer table for category and component ( key: component<<8 | catg_idx )
+	static inthashtable_tpl<uint32, transfer_table_t *> transfer_table_of;
+	static uint32 transfer_table_key(uint8 catg_idx, quickstone_id_t component) { return ((uint32)component << 8) | catg_idx; }
+	/// first table with unfinished rows
+	static uint32 transfer_tables_done;
 
 	/**
-	 * Remember last route search start and catg to resume search
+	 * Creates (empty) transfer tables for the connected components fitting into
+	 * settings_t::transfer_table_memory. To be called after rebuild_connected_components().
 	 */
-	static halthandle_t last_search_origin;
-	static uint8        last_search_ware_catg_idx;
+	static void plan_transfer_tables();
+
+	/// calculates up to @p max_rows rows of the transfer tables
+	static void build_transfer_tables(uint32 max_rows);
+
+	static void calc_transfer_row(transfer_table_t &table, uint16 start);
+
+	/// removes all transfer tables, needed whenever any connection changes
+	static void drop_transfer_tables();
+
+	/// @returns complete transfer table of @p halt for @p catg_idx or NULL
+	static const transfer_table_t *get_transfer_table(halthandle_t halt, uint8 catg_idx);
+
+	/**
+	 * Answers search_route() from the transfer tables.
+	 * @returns -1 if the tables do not cover all start and end halts
+	 */
+	static int search_transfer_tables( const halthandle_t *const start_halts, const uint16 start_halt_count, const vector_tpl<halthandle_t> &end_halts, ware_t &ware, ware_t *const return_ware );
 	
 	// data structure of departure_slot_table below.
 	struct departure_t{
@@ -526,10 +654,15 @@ private:
 	};
 	
 	/*
-	 * Table to hold scheduled departure time of convoy.
-	 * Treated like hash table that allows hash collision.
+	 * Scheduled departure times of convoys, sorted by dep_tick.
+	 * Expired slots are skipped and removed once they are the oldest ones.
 	 */
-	slist_tpl<departure_t> departure_slot_table[DST_SIZE];
+	vector_tpl<departure_t> departure_slots;
+
+	/// @returns index of the first slot with dep_tick not less than @p dep_tick
+	uint32 find_departure(uint32 dep_tick) const;
+
+	bool is_departure_valid(const departure_t &dep) const;
 	
 public:
 	enum routing_result_flags {
@@ -539,6 +672,16 @@ public:
 		ROUTE_OVERCROWDED = 8
 	};
 
+	/**
+	 * Memory of search_route(): best weights, open list and markers.
+	 * The main thread uses its own memory, other threads need one each.
+	 */
+	struct route_search_memory_t;
+
+	/// @returns free memory for search_route() from the pool
+	static route_search_memory_t *get_route_search_memory();
+	static void release_route_search_memory(route_search_memory_t *memory);
+
 	/**
 	 * Kann die Ware nicht zum Ziel geroutet werden (keine Route), dann werden
 	 * Ziel und Zwischenziel auf koord::invalid gesetzt.
@@ -548,8 +691,10 @@ public:
 	 * for reverse routing, also the next to last stop can be added, if next_to_ziel!=NULL
 	 *
 	 * if avoid_overcrowding is set, a valid route in only found when there is no overflowing stop in between
+	 *
+	 * @param memory search memory of the calling thread, NULL on the main thread
 	 */
-	static int search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware=NULL );
+	static int search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware=NULL, route_search_memory_t *memory=NULL );
 
 	/**
 	 * A separate version of route searching code for re-calculating routes
@@ -662,8 +807,18 @@ public:
 	 * @param load Output parameter. Goods will be put into this list, the vehicle has to load them.
 	 * @param good_category Specifies the kind of good (or compatible goods) we are requesting to fetch from this stop.
 	 * @param requested_amount How many units of the cargo we can fetch.
+	 * @param plan loading order of the convoi, call end_loading() when the convoi is done
 	 */
-	void fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *good_category, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts);
+	void fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *good_category, uint32 requested_amount, const vector_tpl<halthandle_t>& destination_halts, loading_plan_t &plan);
+
+	/// drops the goods fetched by a convoi from the storage, if worthwhile
+	void end_loading();
+
+private:
+	/// collects the packets to @p destination_halts in loading order
+	void plan_loading( loading_plan_t::category_t &planned, freight_store_t *wares, const vector_tpl<halthandle_t>& destination_halts);
+
+public:
 
 	/**
 	 * Delivers goods (ware_t) to this halt.
@@ -757,12 +912,12 @@ public:
 	/**
 	 * called, if a line serves this stop
 	 */
-	void add_line(linehandle_t line) { registered_lines.append_unique(line); }
+	void add_line(linehandle_t line) { if(  registered_lines.append_unique(line)  ) { set_connections_dirty(); } }
 
 	/**
 	 * called, if a line removes this stop from it's schedule
 	 */
-	void remove_line(linehandle_t line) { registered_lines.remove(line); }
+	void remove_line(linehandle_t line) { if(  registered_lines.remove(line)  ) { set_connections_dirty(); } }
 
 	/**
 	 * list of line ids that serve this stop
@@ -772,12 +927,12 @@ public:
 	/**
 	 * Register a lineless convoy which serves this stop
 	 */
-	void add_convoy(convoihandle_t convoy) { registered_convoys.append_unique(convoy); }
+	void add_convoy(convoihandle_t convoy) { if(  registered_convoys.append_unique(convoy)  ) { set_connections_dirty(); } }
 
 	/**
 	 * Unregister a lineless convoy
 	 */
-	void remove_convoy(convoihandle_t convoy) { registered_convoys.remove(convoy); }
+	void remove_convoy(convoihandle_t convoy) { if(  registered_convoys.remove(convoy)  ) { set_connections_dirty(); } }
 
 	/**
 	 * A list of lineless convoys serving this stop
@@ -198,7 +198,8 @@ void simline_t::add_convoy(convoihandle_t cnv)
 
 	// do we need to tell the world about our new schedule?
 	if(  update_schedules  ) {
-		welt->set_schedule_counter();
+		haltestelle_t::set_connections_dirty( schedule, player );
+		welt->set_schedule_counter( false );
 	}
 }
 
@@ -224,7 +225,7 @@ void simline_t::remove_convoy(convoihandle_t cnv)
 
 void simline_t::rdwr_linehandle_t(loadsave_t *file, linehandle_t &line)
 {
-	uint16 id;
+	uint32 id;
 	if (file->is_saving()) {
 		id = line.is_bound() ? line.get_id() :
 			 (file->is_version_less(110, 0)  ? INVALID_LINE_ID_OLD : INVALID_LINE_ID);
@@ -240,11 +241,11 @@ void simline_t::rdwr_linehandle_t(loadsave_t *file, linehandle_t &line)
 		id = (uint16)dummy;
 	}
 	else {
-		file->rdwr_short(id);
+		file->rdwr_handle_id(id);
 	}
 	if (file->is_loading()) {
 		// invalid line_id's: 0 and 65535
-		if (id == INVALID_LINE_ID_OLD) {
+		if (id == INVALID_LINE_ID_OLD  &&  file->is_version_less(110, 0)) {
 			id = 0;
 		}
 		line.set_id(id);
@@ -484,14 +485,16 @@ void simline_t::recalc_catg_index()
 	// if different => schedule need recalculation
 	if(  goods_catg_index.get_count()!=old_goods_catg_index.get_count()  ) {
 		// surely changed
-		welt->set_schedule_counter();
+		haltestelle_t::set_connections_dirty( schedule, player );
+		welt->set_schedule_counter( false );
 	}
 	else {
 		// maybe changed => must test all entries
 		FOR(minivec_tpl<uint8>, const i, goods_catg_index) {
 			if (!old_goods_catg_index.is_contained(i)) {
 				// different => recalc
-				welt->set_schedule_counter();
+				haltestelle_t::set_connections_dirty( schedule, player );
+				welt->set_schedule_counter( false );
 				break;
 			}
 		}
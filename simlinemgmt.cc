@@ -65,7 +65,8 @@ void simlinemgmt_t::update_line(linehandle_t line)
 	// finally de/register all stops
 	line->renew_stops();
 	if(  count>0  ) {
-		world()->set_schedule_counter();
+		// the stops were marked when (un)registering the line
+		world()->set_schedule_counter( false );
 	}
 }
 
@@ -6432,7 +6432,7 @@ const char *tool_build_land_chain_t::work( player_t *player, koord3d pos )
 
 			// crossconnect all?
 			if (welt->get_settings().is_crossconnect_factories()) {
-				FOR(slist_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
+				FOR(vector_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
 					f->add_all_suppliers();
 				}
 			}
@@ -6501,7 +6501,7 @@ const char *tool_city_chain_t::work( player_t *player, koord3d pos )
 
 		// crossconnect all?
 		if (welt->get_settings().is_crossconnect_factories()) {
-			FOR(slist_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
+			FOR(vector_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
 				f->add_all_suppliers();
 			}
 		}
@@ -6596,7 +6596,7 @@ const char *tool_build_factory_t::work( player_t *player, koord3d pos )
 
 			// crossconnect all?
 			if (welt->get_settings().is_crossconnect_factories()) {
-				FOR(slist_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
+				FOR(vector_tpl<fabrik_t*>, const f, welt->get_fab_list()) {
 					f->add_all_suppliers();
 				}
 			}
@@ -7913,14 +7913,14 @@ bool scenario_check_convoy(karte_t *welt, player_t *player, convoihandle_t cnv,
 bool tool_change_convoi_t::init( player_t *player )
 {
 	char tool=0;
-	uint16 convoi_id = 0;
+	uint32 convoi_id = 0;
 
 	// skip the rest of the command
 	const char *p = default_param;
 	while(  *p  &&  *p<=' '  ) {
 		p++;
 	}
-	sscanf( p, "%c,%hi", &tool, &convoi_id );
+	sscanf( p, "%c,%u", &tool, &convoi_id );
 
 	// skip to the commands ...
 	for(  int z = 2;  *p  &&  z>0;  p++  ) {
@@ -7990,8 +7990,9 @@ bool tool_change_convoi_t::init( player_t *player )
 		case 'l': // change line
 			{
 				// read out id and new current_stop index
-				uint16 id=0, current_stop=0;
-				int count=sscanf( p, "%hi,%hi", &id, &current_stop );
+				uint32 id=0;
+				uint16 current_stop=0;
+				int count=sscanf( p, "%u,%hi", &id, &current_stop );
 				linehandle_t l;
 				l.set_id( id );
 				if(  l.is_bound()  ) {
@@ -8118,7 +8119,7 @@ bool tool_change_convoi_t::init( player_t *player )
  */
 bool tool_change_line_t::init( player_t *player )
 {
-	uint16 line_id = 0;
+	uint32 line_id = 0;
 
 	// skip the rest of the command
 	const char *p = default_param;
@@ -8397,14 +8398,14 @@ bool tool_change_depot_t::init( player_t *player )
 	char tool=0;
 	koord pos2d;
 	sint8 z;
-	uint16 convoi_id;
+	uint32 convoi_id;
 
 	// skip the rest of the command
 	const char *p = default_param;
 	while(  *p  &&  *p<=' '  ) {
 		p++;
 	}
-	sscanf( p, "%c,%hi,%hi,%hhi,%hi", &tool, &pos2d.x, &pos2d.y, &z, &convoi_id );
+	sscanf( p, "%c,%hi,%hi,%hhi,%u", &tool, &pos2d.x, &pos2d.y, &z, &convoi_id );
 
 	koord3d pos(pos2d, z);
 
@@ -8716,6 +8717,10 @@ bool tool_change_traffic_light_t::init( player_t *player )
 		return false;
 	}
 
+	if(  rs->get_desc()->is_private_way()  ) {
+		// the allowed players are stored in the ticks, routes through here may change
+		weg_t::increment_generation();
+	}
 	if(  ns == 1  ) {
 		rs->set_ticks_ns( (uint8)ticks );
 	}
@@ -8835,7 +8840,7 @@ bool tool_change_city_t::init( player_t *player )
  */
 bool tool_rename_t::init(player_t *player)
 {
-	uint16 id = 0;
+	uint32 id = 0;
 	koord3d pos = koord3d::invalid;
 
 	// skip the rest of the command
@@ -141,6 +141,9 @@ typedef struct{
 	sem_t* wait_for_previous;
 	sem_t* signal_to_next;
 	xy_loop_func function;
+	index_loop_func index_function;
+	uint32 index_min;
+	uint32 index_max;
 	bool keep_running;
 } world_thread_param_t;
 
@@ -159,6 +162,11 @@ void *karte_t::world_xy_loop_thread(void *ptr)
 		sint16 x_min = 0;
 		sint16 x_max = param->x_step;
 
+		if(  param->index_function  ) {
+			// x_world_max is zero then, so the loop below is skipped
+			(param->welt->*(param->index_function))(param->index_min, param->index_max, param->thread_num);
+		}
+
 		while(  x_min < param->x_world_max  ) {
 			// wait for predecessor to finish its block
 			if(  param->wait_for_previous  ) {
@@ -183,7 +191,66 @@ void *karte_t::world_xy_loop_thread(void *ptr)
 
 	return NULL;
 }
+
+
+void karte_t::spawn_world_threads()
+{
+	if(  !spawned_world_threads  ) {
+		// we can do the parallel display using posix threads ...
+		pthread_t thread[MAX_THREADS];
+		/* Initialize and set thread detached attribute */
+		pthread_attr_t attr;
+		pthread_attr_init( &attr );
+		pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+		// init barrier
+		simthread_barrier_init( &world_barrier_start, NULL, env_t::num_threads );
+		simthread_barrier_init( &world_barrier_end, NULL, env_t::num_threads );
+
+		for(  int t = 0;  t < env_t::num_threads - 1;  t++  ) {
+			if(  pthread_create( &thread[t], &attr, world_xy_loop_thread, (void *)&world_thread_param[t] )  ) {
+				dbg->fatal( "karte_t::world_xy_loop()", "cannot multithread, error at thread #%i", t+1 );
+			}
+		}
+		spawned_world_threads = true;
+		pthread_attr_destroy( &attr );
+	}
+}
+#endif
+
+
+void karte_t::world_index_loop(index_loop_func function, uint32 count)
+{
+#ifdef MULTI_THREAD
+	// may be called when simrand() is already forbidden
+	const bool was_interactive = (get_random_mode() & INTERACTIVE_RANDOM) != 0;
+	set_random_mode( INTERACTIVE_RANDOM ); // do not allow simrand() here!
+
+	for(  int t = 0;  t < env_t::num_threads;  t++  ) {
+		world_thread_param[t].welt = this;
+		world_thread_param[t].thread_num = t;
+		world_thread_param[t].x_step = 0;
+		world_thread_param[t].x_world_max = 0;
+		world_thread_param[t].function = NULL;
+		world_thread_param[t].index_function = function;
+		world_thread_param[t].index_min = (uint32)(((uint64)t * count) / env_t::num_threads);
+		world_thread_param[t].index_max = (uint32)(((uint64)(t + 1) * count) / env_t::num_threads);
+		world_thread_param[t].wait_for_previous = NULL;
+		world_thread_param[t].signal_to_next = NULL;
+		world_thread_param[t].keep_running = t < env_t::num_threads - 1;
+	}
+
+	spawn_world_threads();
+
+	// and start processing; the last we can run ourselves
+	world_xy_loop_thread(&world_thread_param[env_t::num_threads-1]);
+
+	if(  !was_interactive  ) {
+		clear_random_mode( INTERACTIVE_RANDOM );
+	}
+#else
+	(this->*function)( 0, count, 0 );
 #endif
+}
 
 
 void karte_t::world_xy_loop(xy_loop_func function, uint8 flags)
@@ -211,6 +278,7 @@ void karte_t::world_xy_loop(xy_loop_func function, uint8 flags)
 		world_thread_param[t].y_min = (t * max_y) / env_t::num_threads;
 		world_thread_param[t].y_max = ((t + 1) * max_y) / env_t::num_threads;
 		world_thread_param[t].function = function;
+		world_thread_param[t].index_function = NULL;
 
 		world_thread_param[t].wait_for_previous = sync_x_steps  &&  t > 0 ? &sems[t-1] : NULL;
 		world_thread_param[t].signal_to_next    = sync_x_steps  &&  t < env_t::num_threads - 1 ? &sems[t] : NULL;
@@ -218,25 +286,7 @@ void karte_t::world_xy_loop(xy_loop_func function, uint8 flags)
 		world_thread_param[t].keep_running = t < env_t::num_threads - 1;
 	}
 
-	if(  !spawned_world_threads  ) {
-		// we can do the parallel display using posix threads ...
-		pthread_t thread[MAX_THREADS];
-		/* Initialize and set thread detached attribute */
-		pthread_attr_t attr;
-		pthread_attr_init( &attr );
-		pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
-		// init barrier
-		simthread_barrier_init( &world_barrier_start, NULL, env_t::num_threads );
-		simthread_barrier_init( &world_barrier_end, NULL, env_t::num_threads );
-
-		for(  int t = 0;  t < env_t::num_threads - 1;  t++  ) {
-			if(  pthread_create( &thread[t], &attr, world_xy_loop_thread, (void *)&world_thread_param[t] )  ) {
-				dbg->fatal( "karte_t::world_xy_loop()", "cannot multithread, error at thread #%i", t+1 );
-			}
-		}
-		spawned_world_threads = true;
-		pthread_attr_destroy( &attr );
-	}
+	spawn_world_threads();
 
 	// and start processing; the last we can run ourselves
 	world_xy_loop_thread(&world_thread_param[env_t::num_threads-1]);
@@ -448,6 +498,8 @@ void karte_t::destroy()
 		}
 	}
 	convoi_array.clear();
+	convoi_route_requests.clear();
+	route_t::clear_cache();
 	DBG_MESSAGE("karte_t::destroy()", "convois destroyed");
 
 	// alle haltestellen aufraeumen
@@ -457,7 +509,7 @@ void karte_t::destroy()
 	ls.set_progress( old_progress );
 
 	// remove all target cities (we can skip recalculation anyway)
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 		f->clear_target_cities();
 	}
 
@@ -503,10 +555,11 @@ void karte_t::destroy()
 	ls.set_progress( old_progress );
 
 	// alle fabriken aufraeumen
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 		delete f;
 	}
 	fab_list.clear();
+	fab_set.clear();
 	DBG_MESSAGE("karte_t::destroy()", "factories destroyed");
 
 	// hier nur entfernen, aber nicht loeschen
@@ -533,6 +586,16 @@ void karte_t::add_convoi(convoihandle_t const cnv)
 void karte_t::rem_convoi(convoihandle_t const cnv)
 {
 	convoi_array.remove(cnv);
+	convoi_route_requests.remove(cnv);
+}
+
+
+void karte_t::request_convoi_route(convoihandle_t const cnv)
+{
+	if(  !cnv->is_route_requested()  ) {
+		cnv->set_route_requested(true);
+		convoi_route_requests.append(cnv);
+	}
 }
 
 
@@ -572,7 +635,7 @@ bool karte_t::remove_city(stadt_t *s)
 
 	// remove all links from factories
 	DBG_DEBUG4("karte_t::remove_city()", "fab_list %i", fab_list.get_count() );
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 		f->remove_target_city(s);
 	}
 
@@ -1204,6 +1267,7 @@ void karte_t::init(settings_t* const sets, sint8 const* const h_field)
 	ticks = 0;
 	last_step_ticks = ticks;
 	schedule_counter = 0;
+	reconnect_all_counter = 0;
 	// ticks = 0x7FFFF800;  // Testing the 31->32 bit step
 
 	last_month = 0;
@@ -1216,6 +1280,8 @@ void karte_t::init(settings_t* const sets, sint8 const* const h_field)
 	network_frame_count = 0;
 	sync_steps = 0;
 	sync_steps_barrier = sync_steps;
+	current_sync_list = NULL;
+	current_reconnect_halts = NULL;
 	map_counter = 0;
 	recalc_average_speed(); // resets timeline
 	koord::locality_factor = settings.get_locality_factor( last_year );
@@ -1451,7 +1517,10 @@ void karte_t::create_lakes(  int xoff, int yoff, sint8 max_lake_height  )
 
 		global_lake_fill = (env_t::num_threads == 1);
 
+		weg_t::freeze_generation(true);
 		world_xy_loop(&karte_t::create_lakes_loop, 0);
+		weg_t::freeze_generation(false);
+		weg_t::increment_generation();
 
 		if(need_to_flood) {
 			flood_to_depth(  h, stage  );
@@ -1864,7 +1933,10 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 			}
 		}
 		else {
+			weg_t::freeze_generation(true);
 			world_xy_loop(&karte_t::perlin_hoehe_loop, GRIDS_FLAG);
+			weg_t::freeze_generation(false);
+			weg_t::increment_generation();
 			ls.set_progress(2);
 		}
 		exit_perlin_map();
@@ -2132,6 +2204,7 @@ karte_t::karte_t() :
 	grid_hgts = 0;
 	water_hgts = 0;
 	schedule_counter = 0;
+	reconnect_all_counter = 0;
 	nosave_warning = nosave = false;
 	loaded_rotation = 0;
 	last_year = 1930;
@@ -3321,7 +3394,10 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	rotate90_new_plan = new planquadrat_t[cached_grid_size.y * cached_grid_size.x];
 	rotate90_new_water = new sint8[cached_grid_size.y * cached_grid_size.x];
 
+	weg_t::freeze_generation(true);
 	world_xy_loop(&karte_t::rotate90_plans, 0);
+	weg_t::freeze_generation(false);
+	weg_t::increment_generation();
 
 	grund_t::finish_rotate90();
 
@@ -3364,7 +3440,7 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	}
 
 	// fixed order factory, halts, convois
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 		f->rotate90(cached_size.x);
 	}
 	// after rotation of factories, rotate everything that holds freight: stations and convoys
@@ -3425,7 +3501,9 @@ bool karte_t::add_fab(fabrik_t *fab)
 {
 //DBG_MESSAGE("karte_t::add_fab()","fab = %p",fab);
 	assert(fab != NULL);
-	fab_list.insert( fab );
+	// first, as in older games; factories are built rarely, so moving the others does not matter
+	fab_list.insert_at( 0, fab );
+	fab_set.put( fab, true );
 	goods_in_game.clear(); // Force rebuild of goods list
 	return true;
 }
@@ -3437,6 +3515,7 @@ bool karte_t::rem_fab(fabrik_t *fab)
 	if(!fab_list.remove( fab )) {
 		return false;
 	}
+	fab_set.remove( fab );
 
 	// Force rebuild of goods list
 	goods_in_game.clear();
@@ -3464,7 +3543,7 @@ bool karte_t::rem_fab(fabrik_t *fab)
 		}
 
 		// remove all links from factories
-		FOR(slist_tpl<fabrik_t*>, const fab, fab_list) {
+		FOR(vector_tpl<fabrik_t*>, const fab, fab_list) {
 			fab->rem_lieferziel(k);
 			fab->rem_supplier(k);
 		}
@@ -3580,32 +3659,173 @@ bool karte_t::sync_list_t::is_contained(sync_steppable *obj)
 	return list.is_contained(obj);
 }
 
+// marks objects in results, which still need sync_step()
+#define SYNC_PENDING (0xFF)
+
+void karte_t::sync_list_t::sync_step_local(uint32 index_min, uint32 index_max)
+{
+	for(  uint32 i = index_min;  i < index_max;  i++  ) {
+		sync_result result;
+		results[i] = list[i]->sync_step_local( current_delta_t, result ) ? result : SYNC_PENDING;
+	}
+}
+
+
 void karte_t::sync_list_t::sync_step(uint32 delta_t)
 {
 	sync_step_running = true;
 	currently_deleting = NULL;
 
-	for(uint32 i=0; i<list.get_count();i++) {
+	const uint32 count = list.get_count();
+	if(  count == 0  ) {
+		sync_step_running = false;
+		return;
+	}
+	results.clear();
+	results.store_at( count-1, SYNC_PENDING );
+	current_delta_t = delta_t;
+
+	// first all objects which do not touch others
+#ifdef MULTI_THREAD
+	if(  env_t::parallel_sync_step  &&  env_t::num_threads > 1  &&  count >= 64u*env_t::num_threads  ) {
+		karte_t *welt = ::world();
+		welt->current_sync_list = this;
+		welt->world_index_loop( &karte_t::sync_step_local_loop, count );
+		welt->current_sync_list = NULL;
+	}
+	else
+#endif
+	{
+		sync_step_local( 0, count );
+	}
+
+	// then the rest in fixed order
+	for(  uint32 i = 0;  i < count;  i++  ) {
 		sync_steppable *ss = list[i];
-		switch(ss->sync_step(delta_t)) {
-			case SYNC_OK:
-				break;
-			case SYNC_DELETE:
-				currently_deleting = ss;
-				delete ss;
-				currently_deleting = NULL;
-				/* fall-through */
-			case SYNC_REMOVE:
-				ss = list.pop_back();
-				if (i < list.get_count()) {
-					list[i] = ss;
-				}
+		if(  results[i] == SYNC_PENDING  ) {
+			results[i] = ss->sync_step( delta_t );
+		}
+		if(  results[i] == SYNC_DELETE  ) {
+			currently_deleting = ss;
+			delete ss;
+			currently_deleting = NULL;
+		}
+	}
+
+	// finally remove the deleted and removed objects
+	for(  uint32 i = 0;  i < list.get_count();  ) {
+		if(  results[i] == SYNC_OK  ) {
+			i++;
+		}
+		else {
+			list[i] = list.back();
+			results[i] = results.back();
+			list.pop_back();
+			results.pop_back();
 		}
 	}
 	sync_step_running = false;
 }
 
 
+void karte_t::sync_step_local_loop(uint32 index_min, uint32 index_max, sint8)
+{
+	current_sync_list->sync_step_local( index_min, index_max );
+}
+
+
+void karte_t::route_passengers_loop(uint32 index_min, uint32 index_max, sint8)
+{
+	stadt_t::route_pax_requests( index_min, index_max, true );
+}
+
+
+void karte_t::route_passengers()
+{
+	const uint32 count = stadt_t::get_pax_request_count();
+#ifdef MULTI_THREAD
+	if(  env_t::parallel_passenger_routing  &&  env_t::num_threads > 1  ) {
+		world_index_loop( &karte_t::route_passengers_loop, count );
+	}
+	else
+#endif
+	{
+		stadt_t::route_pax_requests( 0, count, false );
+	}
+	// booking changes the halts, so it is done afterwards in the order of generation
+	stadt_t::book_pax_requests();
+}
+
+
+void karte_t::step_factories_loop(uint32 index_min, uint32 index_max, sint8)
+{
+	for(  uint32 i = index_min;  i < index_max;  i++  ) {
+		if(  fab_list[i]->get_input().empty()  ) {
+			fab_list[i]->step_production( factory_delta_t );
+		}
+	}
+}
+
+
+void karte_t::step_factories(uint32 delta_t)
+{
+	factory_delta_t = delta_t;
+	bool production_done = false;
+#ifdef MULTI_THREAD
+	// a factory without input is not touched by the distribution of other factories,
+	// so its production gives the same result before the serial pass
+	if(  env_t::parallel_factory_step  &&  env_t::num_threads > 1  ) {
+		world_index_loop( &karte_t::step_factories_loop, fab_list.get_count() );
+		production_done = true;
+	}
+#endif
+	// distribution changes the demands of consumers, halts and the map,
+	// so consumers produce right before their own distribution like before
+	FOR(vector_tpl<fabrik_t *>, const f, fab_list) {
+		if(  !production_done  ||  !f->get_input().empty()  ) {
+			f->step_production( delta_t );
+		}
+		f->step( delta_t );
+	}
+	fabrik_t::clear_distribution_routes();
+}
+
+
+void karte_t::rebuild_halt_connections_loop(uint32 index_min, uint32 index_max, sint8)
+{
+	haltestelle_t::reconnect_scratch_t scratch;
+	for(  uint32 i = index_min;  i < index_max;  i++  ) {
+		halthandle_t halt = (*current_reconnect_halts)[i];
+		if(  halt.is_bound()  ) {
+			halt->rebuild_connections( scratch, false );
+		}
+	}
+}
+
+
+void karte_t::rebuild_halt_connections(const vector_tpl<halthandle_t> &halts)
+{
+	current_reconnect_halts = &halts;
+#ifdef MULTI_THREAD
+	if(  env_t::parallel_reconnect  &&  env_t::num_threads > 1  ) {
+		world_index_loop( &karte_t::rebuild_halt_connections_loop, halts.get_count() );
+	}
+	else
+#endif
+	{
+		// serial: interrupt after each halt, a full reconnect on a large map takes a while
+		haltestelle_t::reconnect_scratch_t scratch;
+		for(  uint32 i = 0;  i < halts.get_count();  i++  ) {
+			if(  halts[i].is_bound()  ) {
+				halts[i]->rebuild_connections( scratch, false );
+				INT_CHECK( "simworld 3806" );
+			}
+		}
+	}
+	current_reconnect_halts = NULL;
+}
+
+
 /*
  * this routine is called before an image is displayed
  * it moves vehicles and pedestrians
@@ -3858,6 +4078,11 @@ void karte_t::new_month()
 		}
 	}
 	DBG_MESSAGE( "karte_t::new_month()", "Month (%d/%d) has started", (last_month % 12) + 1, last_month / 12 );
+#ifdef DEBUG
+	uint32 route_cache_hits, route_cache_misses;
+	route_t::get_cache_statistics( route_cache_hits, route_cache_misses );
+	DBG_MESSAGE( "karte_t::new_month()", "route cache: %u hits, %u misses (size %u)", route_cache_hits, route_cache_misses, env_t::route_cache_size );
+#endif
 
 	// this should be done before a map update, since the map may want an update of the way usage
 	FOR( slist_tpl<weg_t*>, const w, weg_t::get_alle_wege() ) {
@@ -3870,9 +4095,10 @@ void karte_t::new_month()
 	INT_CHECK( "simworld 1701" );
 
 //	DBG_MESSAGE("karte_t::new_month()","factories");
-	FOR(slist_tpl<fabrik_t*>, const fab, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const fab, fab_list) {
 		fab->new_month();
 	}
+	ware_production_t::roll_all_stats();
 	INT_CHECK("simworld 1278");
 
 
@@ -4114,12 +4340,38 @@ void karte_t::notify_record( convoihandle_t cnv, sint32 max_speed, koord k )
 }
 
 
-void karte_t::set_schedule_counter()
+void karte_t::set_schedule_counter(bool all_halts)
 {
 	// do not call this from gui when playing in network mode!
 	assert( (get_random_mode() & INTERACTIVE_RANDOM) == 0  );
 
 	schedule_counter++;
+	if(  all_halts  ) {
+		reconnect_all_counter++;
+	}
+}
+
+
+void karte_t::prepare_convoi_step_loop(uint32 index_min, uint32 index_max, sint8)
+{
+	route_t::search_context_holder_t ctx(false);
+	for(  uint32 i = index_min;  i < index_max;  i++  ) {
+		convoi_array[i]->prepare_step( *ctx );
+	}
+}
+
+
+// route searches after schedule changes per step; must be the same on all clients
+#define CONVOI_ROUTE_REQUESTS_PER_STEP (16)
+
+void karte_t::serve_convoi_route_requests()
+{
+	for(  uint32 n = 0;  n < CONVOI_ROUTE_REQUESTS_PER_STEP  &&  !convoi_route_requests.empty();  n++  ) {
+		convoihandle_t cnv = convoi_route_requests.remove_first();
+		if(  cnv.is_bound()  ) {
+			cnv->set_route_requested(false);
+		}
+	}
 }
 
 
@@ -4131,6 +4383,9 @@ void karte_t::step()
 	// calculate delta_t before handling overflow in ticks
 	uint32 delta_t = ticks - last_step_ticks;
 
+	// where citycars are simulated in this step
+	private_car_t::update_detail_map( this );
+
 	// first: check for new month
 	if(ticks > next_month_ticks) {
 
@@ -4231,6 +4486,14 @@ void karte_t::step()
 	INT_CHECK("karte_t::step");
 
 	DBG_DEBUG4("karte_t::step", "step convois");
+	serve_convoi_route_requests();
+#ifdef MULTI_THREAD
+	if(  env_t::parallel_convoi_step  &&  env_t::num_threads > 1  ) {
+		// first search the routes needed in this step in parallel,
+		// the results are used when stepping the convois in the usual order below
+		world_index_loop( &karte_t::prepare_convoi_step_loop, convoi_array.get_count() );
+	}
+#endif
 	// since convois will be deleted during stepping, we need to step backwards
 	for (size_t i = convoi_array.get_count(); i-- != 0;) {
 		convoihandle_t cnv = convoi_array[i];
@@ -4247,14 +4510,13 @@ void karte_t::step()
 		i->step(delta_t);
 		bev += i->get_finance_history_month(0, HIST_CITIZENS);
 	}
+	route_passengers();
 
 	// the inhabitants stuff
 	finance_history_month[0][WORLD_CITIZENS] = bev;
 
 	DBG_DEBUG4("karte_t::step", "step factories");
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
-		f->step(delta_t);
-	}
+	step_factories(delta_t);
 	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
 
 	// step powerlines - required order: powernet, pumpe then senke
@@ -5323,7 +5585,10 @@ DBG_MESSAGE("karte_t::load()", "%d ways loaded",weg_t::get_alle_wege().get_count
 
 	ls.set_progress( (get_size().y*3)/2+256 );
 
+	weg_t::freeze_generation(true);
 	world_xy_loop(&karte_t::plans_finish_rd, SYNCX_FLAG);
+	weg_t::freeze_generation(false);
+	weg_t::increment_generation();
 
 	// update power nets with correct power
 	powernet_t::step_all(1);
@@ -5351,7 +5616,7 @@ DBG_MESSAGE("karte_t::load()", "laden_abschliesen for tiles finished" );
 	ls.set_progress( (get_size().y*3)/2+256+get_size().y/4 );
 
 	DBG_MESSAGE("karte_t::load()", "clean up factories");
-	FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 		f->finish_rd();
 	}
 
@@ -5427,7 +5692,7 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 	// reroute goods for benchmarking
 	dt = dr_time();
 	FOR(vector_tpl<halthandle_t>, const i, haltestelle_t::get_alle_haltestellen()) {
-		sint16 dummy = 0x7FFF;
+		sint32 dummy = 0x7FFFFFFF;
 		i->reroute_goods(dummy);
 	}
 	DBG_MESSAGE("reroute_goods()","for all haltstellen_t took %ld ms", dr_time()-dt );
@@ -5876,6 +6141,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 			fabrik_t *fab = new fabrik_t(file);
 			if(fab->get_desc()) {
 				fab_list.append( fab );
+				fab_set.put( fab, true );
 			}
 			else {
 				dbg->error("karte_t::rdwr_gamestate()","Unknown factory skipped!");
@@ -5889,7 +6155,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 	else {
 		sint32 fabs = fab_list.get_count();
 		file->rdwr_long(fabs);
-		FOR(slist_tpl<fabrik_t*>, const f, fab_list) {
+		FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
 			f->rdwr(file);
 			if(!ls) {
 				INT_CHECK("saving");
@@ -5940,10 +6206,11 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 	// rdwr convois
 	if (file->is_loading()) {
 		DBG_MESSAGE("karte_t::rdwr_gamestate()", "load convois");
-		uint16 convoi_nr = 65535;
-		uint16 max_convoi = 65535;
+		uint32 convoi_nr = 65535;
+		uint32 max_convoi = 65535;
 		if(  file->is_version_atleast(101, 0)  ) {
-			file->rdwr_short(convoi_nr);
+			// at most one per handle index
+			file->rdwr_handle_id(convoi_nr);
 			max_convoi = convoi_nr;
 		}
 
@@ -5981,8 +6248,8 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 	else {
 		// save number of convois
 		if(  file->is_version_atleast(101, 0)  ) {
-			uint16 i=convoi_array.get_count();
-			file->rdwr_short(i);
+			uint32 i=convoi_array.get_count();
+			file->rdwr_handle_id(i);
 		}
 		FOR(vector_tpl<convoihandle_t>, const cnv, convoi_array) {
 			// one MUST NOT call INT_CHECK here or else the convoi will be broken during reloading!
@@ -7708,7 +7975,7 @@ const vector_tpl<const goods_desc_t*> &karte_t::get_goods_list()
 			d->selected_filter = VEHICLE_FILTER_RELEVANT;
 		}
 
-		FOR(slist_tpl<fabrik_t*>, const factory, get_fab_list()) {
+		FOR(vector_tpl<fabrik_t*>, const factory, get_fab_list()) {
 			slist_tpl<goods_desc_t const*>* const produced_goods = factory->get_produced_goods();
 			FOR(slist_tpl<goods_desc_t const*>, const good, *produced_goods) {
 				goods_in_game.insert_unique_ordered(good, sort_ware_by_name);
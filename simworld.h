@@ -18,6 +18,7 @@
 #include "tpl/array2d_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/slist_tpl.h"
+#include "tpl/ptrhashtable_tpl.h"
 
 #include "dataobj/settings.h"
 #include "dataobj/loadsave.h"
@@ -57,6 +58,11 @@ class loadingscreen_t;
  */
 typedef void (karte_t::*xy_loop_func)(sint16, sint16, sint16, sint16);
 
+/**
+ * Threaded function caller for index ranges, gets also the number of the calling thread.
+ */
+typedef void (karte_t::*index_loop_func)(uint32, uint32, sint8);
+
 
 /**
  * The map is the central part of the simulation. It stores all data and objects.
@@ -272,9 +278,20 @@ private:
 	vector_tpl<convoihandle_t> convoi_array;
 
 	/**
-	 * Array containing the factories.
+	 * Convois waiting for their route search after a schedule change,
+	 * served in this order at the start of the convoi step.
+	 */
+	slist_tpl<convoihandle_t> convoi_route_requests;
+
+	/**
+	 * All factories, the latest built first. They are stepped and saved in this order.
+	 * Indices change when a factory is built or removed. Factories are identified by
+	 * their position instead, see fabrik_t::get_fab(koord), which finds them via the map.
 	 */
-	slist_tpl<fabrik_t *> fab_list;
+	vector_tpl<fabrik_t *> fab_list;
+
+	/// the factories of fab_list, to check quickly if a factory still exists
+	ptrhashtable_tpl<const fabrik_t *, bool> fab_set;
 
 	/**
 	 * Stores a list of goods produced by factories currently in the game;
@@ -444,6 +461,12 @@ private:
 	 */
 	uint8 schedule_counter;
 
+	/**
+	 * Counter for changes which need new connections for all halts,
+	 * see haltestelle_t::step_all().
+	 */
+	uint8 reconnect_all_counter;
+
 	/**
 	 * @name Display timing and scheduling
 	 *       These variables store system display timings in the past frames
@@ -695,6 +718,23 @@ private:
 
 	void world_xy_loop(xy_loop_func func, uint8 flags);
 	static void *world_xy_loop_thread(void *);
+	static void spawn_world_threads();
+
+	/**
+	 * Calls @p func for the indices 0 ... @p count-1, split into one range per thread.
+	 * Shares the threads with world_xy_loop().
+	 */
+	void world_index_loop(index_loop_func func, uint32 count);
+
+	/**
+	 * Lets the convois search their routes for this step in advance, see convoi_t::prepare_step()
+	 */
+	void prepare_convoi_step_loop(uint32 index_min, uint32 index_max, sint8 thread_nr);
+
+	/**
+	 * Releases the next queued convois for their route search in this step.
+	 */
+	void serve_convoi_route_requests();
 
 	/**
 	 * Loops over plans after load.
@@ -935,8 +975,12 @@ public:
 	/**
 	 * If a schedule is changed, it will increment the schedule counter
 	 * every step the haltestelle will check and reroute the goods if needed.
+	 * @param all_halts false, if only the stops of changed schedules need new connections;
+	 *        these are marked by haltestelle_t::set_connections_dirty()
 	 */
-	void set_schedule_counter();
+	void set_schedule_counter(bool all_halts = true);
+
+	uint8 get_reconnect_all_counter() const { return reconnect_all_counter; }
 
 	/**
 	 * @note Often used, therefore found here.
@@ -1493,6 +1537,12 @@ public:
 	// the convois are also handled each step => thus we keep track of them too
 	void add_convoi(convoihandle_t);
 	void rem_convoi(convoihandle_t);
+
+	/**
+	 * Queues the route search of @p cnv after a schedule change. Only a fixed number
+	 * of searches is done per step, so changing a line with many convois does not stall the game.
+	 */
+	void request_convoi_route(convoihandle_t cnv);
 	vector_tpl<convoihandle_t> const& convoys() const { return convoi_array; }
 
 	/**
@@ -1517,9 +1567,12 @@ public:
 
 	bool add_fab(fabrik_t *fab);
 	bool rem_fab(fabrik_t *fab);
-	int get_fab_index(fabrik_t* fab)  const { return fab_list.index_of(fab); }
-	fabrik_t* get_fab(unsigned index) const { return index < fab_list.get_count() ? fab_list.at(index) : NULL; }
-	const slist_tpl<fabrik_t*>& get_fab_list() const { return fab_list; }
+	/// @p index in fab_list, only valid until the next factory is built or removed
+	fabrik_t* get_fab(unsigned index) const { return index < fab_list.get_count() ? fab_list[index] : NULL; }
+	const vector_tpl<fabrik_t*>& get_fab_list() const { return fab_list; }
+
+	/// @returns true, if @p fab is a factory on this map
+	bool is_fab(const fabrik_t *fab) const { return fab_set.get(fab); }
 
 	/**
 	 * Returns a list of goods produced by factories that exist in current game.
@@ -1545,16 +1598,24 @@ public:
 	class sync_list_t {
 			friend class karte_t;
 		public:
-			sync_list_t() : currently_deleting(NULL), sync_step_running(false) {}
+			sync_list_t() : current_delta_t(0), currently_deleting(NULL), sync_step_running(false) {}
 			void add(sync_steppable *obj);
 			void remove(sync_steppable *obj);
 			bool is_contained(sync_steppable *obj);
 		private:
+			/**
+			 * First all objects, which change only themselves, are stepped (in parallel),
+			 * then the remaining ones in list order. So the result does not depend on the number of threads.
+			 */
 			void sync_step(uint32 delta_t);
+			/// sync_step_local() for the objects index_min ... index_max-1
+			void sync_step_local(uint32 index_min, uint32 index_max);
 			/// clears list, does not delete the objects
 			void clear();
 
 			vector_tpl<sync_steppable *> list;  ///< list of sync-steppable objects
+			vector_tpl<uint8> results;          ///< sync_result of each object during sync_step
+			uint32 current_delta_t;
 			sync_steppable* currently_deleting; ///< deleted durign sync_step, safeguard calls to remove
 			bool sync_step_running;
 	};
@@ -1573,7 +1634,42 @@ public:
 	 */
 	void step();
 
+	/**
+	 * Rebuilds the connections of all @p halts at once (on all threads if enabled),
+	 * see haltestelle_t::rebuild_connections().
+	 */
+	void rebuild_halt_connections(const vector_tpl<halthandle_t> &halts);
+
 private:
+	/// list currently processed by sync_step_local_loop()
+	sync_list_t *current_sync_list;
+
+	void sync_step_local_loop(uint32 index_min, uint32 index_max, sint8 thread_nr);
+
+	/// halts currently processed by rebuild_halt_connections_loop()
+	const vector_tpl<halthandle_t> *current_reconnect_halts;
+
+	void rebuild_halt_connections_loop(uint32 index_min, uint32 index_max, sint8 thread_nr);
+
+	/**
+	 * Searches the routes of the passengers and mail generated by the cities in this step
+	 * (on all threads if enabled) and books them afterwards.
+	 */
+	void route_passengers();
+
+	void route_passengers_loop(uint32 index_min, uint32 index_max, sint8 thread_nr);
+
+	/// delta_t for step_factories_loop()
+	uint32 factory_delta_t;
+
+	/**
+	 * Steps all factories in the order of fab_list like a serial step would.
+	 * The production of factories without input is done before (on all threads if enabled).
+	 */
+	void step_factories(uint32 delta_t);
+
+	void step_factories_loop(uint32 index_min, uint32 index_max, sint8 thread_nr);
+
 	inline planquadrat_t *access_nocheck(int i, int j) const {
 		return &plan[i + j*cached_grid_size.x];
 	}
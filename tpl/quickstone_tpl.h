@@ -10,6 +10,21 @@
 #include "../simtypes.h"
 #include "../simdebug.h"
 
+
+/**
+ * Type of the handle indices. With QUICKSTONE_32BIT there can be more than
+ * 65535 halts, convoys and lines at the cost of larger handles.
+ * Indices above QUICKSTONE_MAX_ID are never used.
+ */
+#ifdef QUICKSTONE_32BIT
+typedef uint32 quickstone_id_t;
+// more would not fit into the window magic numbers
+#define QUICKSTONE_MAX_ID (0xFFFFFF)
+#else
+typedef uint16 quickstone_id_t;
+#define QUICKSTONE_MAX_ID (0xFFFF)
+#endif
+
 /**
  * An implementation of the tombstone pointer checking method.
  * It uses a table of pointers and indices into that table to
@@ -31,25 +46,25 @@ private:
 	/**
 	 * Next entry to check
 	 */
-	static uint16 next;
+	static quickstone_id_t next;
 
 	/**
 	 * Size of tombstone table
 	 */
-	static uint16 size;
+	static quickstone_id_t size;
 
 	/**
 	 * The index in the table for this handle.
 	 * (only this variable is actually saved, since the rest is static!)
 	 */
-	uint16 entry;
+	quickstone_id_t entry;
 
 private:
 	/**
 	 * Retrieves next free tombstone index
 	 */
-	static uint16 find_next() {
-		uint16 i;
+	static quickstone_id_t find_next() {
+		quickstone_id_t i;
 
 		// scan rest of array
 		for(  i=next;  i<size;  i++  ) {
@@ -69,17 +84,17 @@ private:
 		return enlarge();
 	}
 
-	static uint16 enlarge()
+	static quickstone_id_t enlarge()
 	{
 		// no free entry found, extend array if possible
-		uint16 newsize;
-		if (size == 65535) {
+		quickstone_id_t newsize;
+		if (size == QUICKSTONE_MAX_ID) {
 			// completely out of handles
-			dbg->fatal("quickstone<T>::find_next()","no free index found (size=%i)",size);
+			dbg->fatal("quickstone<T>::find_next()","no free index found (size=%u)",size);
 			return 0; //dummy for compiler
-		} else if (size >= 32768) {
-			// max out on handles, don't overflow uint16
-			newsize = 65535;
+		} else if (size >= QUICKSTONE_MAX_ID/2+1) {
+			// max out on handles, don't overflow quickstone_id_t
+			newsize = QUICKSTONE_MAX_ID;
 		} else {
 			newsize = 2*size;
 		}
@@ -87,7 +102,7 @@ private:
 		// Move data to new extended array
 		T ** newdata = new T* [newsize];
 		memcpy( newdata, data, sizeof(T*)*size );
-		for(  uint16 i=size;  i<newsize;  i++  ) {
+		for(  quickstone_id_t i=size;  i<newsize;  i++  ) {
 			newdata[i] = 0;
 		}
 		delete [] data;
@@ -104,14 +119,14 @@ public:
 	 *
 	 * @param n number of elements
 	 */
-	static void init(const uint16 n)
+	static void init(const quickstone_id_t n)
 	{
 		delete [] data;
 		size = n;
 		data = new T* [size];
 
 		// all NULL pointers are mapped to entry 0
-		for(int i=0; i<size; i++) {
+		for(  quickstone_id_t i=0;  i<size;  i++  ) {
 			data[i] = 0;
 		}
 		next = 1;
@@ -139,10 +154,10 @@ public:
 	// connects with last handle
 	explicit quickstone_tpl(T* p, bool)
 	{
-		uint16 i;
+		quickstone_id_t i;
 
 		// scan rest of array
-		for(  i=size-1;  i>0;  i++  ) {
+		for(  i=size-1;  i>0;  i--  ) {
 			if(  data[i] == 0  ) {
 				entry = i;
 				data[entry] = p;
@@ -151,7 +166,7 @@ public:
 		}
 		enlarge();
 		// repeat
-		for(  i=size-1;  i>0;  i++  ) {
+		for(  i=size-1;  i>0;  i--  ) {
 			if(  data[i] == 0  ) {
 				entry = i;
 				data[entry] = p;
@@ -162,24 +177,24 @@ public:
 	}
 
 	// creates handle with id, fails if already taken
-	quickstone_tpl(T* p, uint16 id)
+	quickstone_tpl(T* p, quickstone_id_t id)
 	{
 		if(p) {
 			if(  id == 0  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","wants to assign non-null pointer to null index");
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","wants to assign non-null pointer to null index");
 			}
 			while(  id >= size  ) {
 				enlarge();
 			}
 			if(  data[id]!=NULL  &&  data[id]!=p  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","slot (%d) already taken", id);
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","slot (%u) already taken", id);
 			}
 			entry = id;
 			data[entry] = p;
 		}
 		else {
 			if(  id!=0  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","wants to assign null pointer to non-null index");
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","wants to assign null pointer to non-null index");
 			}
 			// all NULL pointers are mapped to entry 0
 			entry = 0;
@@ -189,9 +204,9 @@ public:
 	// returns true, if no handles left
 	static bool is_exhausted()
 	{
-		if(  size==65535  ) {
+		if(  size==QUICKSTONE_MAX_ID  ) {
 			// scan  array
-			for(  uint16 i = 1; i<size; i++) {
+			for(  quickstone_id_t i = 1; i<size; i++) {
 				if(data[i] == 0) {
 					// still empty handles left
 					return false;
@@ -234,13 +249,13 @@ public:
 	 * @return the index into the tombstone table. May be used as
 	 * an ID for the referenced object.
 	 */
-	uint16 get_id() const { return entry; }
+	quickstone_id_t get_id() const { return entry; }
 
 	/**
 	 * Sets the current id: Needed to recreate stuff via network.
 	 * ATTENTION: This may be harmful. DO not use unless really really needed!
 	 */
-	void set_id(uint16 e) { entry=e; }
+	void set_id(quickstone_id_t e) { entry=e; }
 
 	/**
 	 * Overloaded dereference operator. With this, quickstones can
@@ -254,18 +269,18 @@ public:
 
 	bool operator!= (const quickstone_tpl<T> &other) const { return entry != other.entry; }
 
-	static uint16 get_size() { return size; }
+	static quickstone_id_t get_size() { return size; }
 
 	/**
 	 * For checking the consistency of handle allocation
 	 * among the server and the clients in network mode
 	 */
-	static uint16 get_next_check() { return next; }
+	static quickstone_id_t get_next_check() { return next; }
 };
 
 template <class T> T** quickstone_tpl<T>::data = 0;
 
-template <class T> uint16 quickstone_tpl<T>::next = 1;
-template <class T> uint16 quickstone_tpl<T>::size = 0;
+template <class T> quickstone_id_t quickstone_tpl<T>::next = 1;
+template <class T> quickstone_id_t quickstone_tpl<T>::size = 0;
 
 #endif
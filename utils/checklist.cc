@@ -21,7 +21,7 @@ checklist_t::checklist_t() :
 }
 
 
-checklist_t::checklist_t(uint32 _random_seed, uint16 _halt_entry, uint16 _line_entry, uint16 _convoy_entry) :
+checklist_t::checklist_t(uint32 _random_seed, uint32 _halt_entry, uint32 _line_entry, uint32 _convoy_entry) :
 	random_seed(_random_seed),
 	halt_entry(_halt_entry),
 	line_entry(_line_entry),
@@ -49,9 +49,9 @@ bool checklist_t::operator!=(const checklist_t& other) const
 void checklist_t::rdwr(memory_rw_t *buffer)
 {
 	buffer->rdwr_long(random_seed);
-	buffer->rdwr_short(halt_entry);
-	buffer->rdwr_short(line_entry);
-	buffer->rdwr_short(convoy_entry);
+	buffer->rdwr_long(halt_entry);
+	buffer->rdwr_long(line_entry);
+	buffer->rdwr_long(convoy_entry);
 }
 
 
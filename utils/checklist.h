@@ -17,7 +17,7 @@ struct checklist_t
 {
 public:
 	checklist_t();
-	checklist_t(uint32 _random_seed, uint16 _halt_entry, uint16 _line_entry, uint16 _convoy_entry);
+	checklist_t(uint32 _random_seed, uint32 _halt_entry, uint32 _line_entry, uint32 _convoy_entry);
 
 	bool operator==(const checklist_t &other) const;
 	bool operator!=(const checklist_t &other) const;
@@ -27,9 +27,10 @@ public:
 
 public:
 	uint32 random_seed;
-	uint16 halt_entry;
-	uint16 line_entry;
-	uint16 convoy_entry;
+	// next handle checks, wide enough for QUICKSTONE_32BIT
+	uint32 halt_entry;
+	uint32 line_entry;
+	uint32 convoy_entry;
 };
 
 #endif
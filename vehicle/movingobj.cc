@@ -281,6 +281,16 @@ sync_result movingobj_t::sync_step(uint32 delta_t)
 }
 
 
+bool movingobj_t::sync_step_local(uint32 delta_t, sync_result &result)
+{
+	if(  will_hop( weg_next + get_desc()->get_speed()*delta_t )  ) {
+		return false;
+	}
+	result = sync_step( delta_t );
+	return true;
+}
+
+
 /* essential to find out about next step
  * returns true, if we can go here
  * (identical to fahrer)
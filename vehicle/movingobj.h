@@ -55,6 +55,7 @@ public:
 	~movingobj_t();
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE;
 
 	// always free
 	virtual bool check_next_tile(const grund_t *) const;
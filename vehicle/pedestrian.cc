@@ -247,6 +247,17 @@ sync_result pedestrian_t::sync_step(uint32 delta_t)
 }
 
 
+bool pedestrian_t::sync_step_local(uint32 delta_t, sync_result &result)
+{
+	if(  time_to_life > (sint32)delta_t  &&  will_hop( weg_next + 128*delta_t )  ) {
+		// next tile: random direction and other objects
+		return false;
+	}
+	result = sync_step( delta_t );
+	return true;
+}
+
+
 grund_t* pedestrian_t::hop_check()
 {
 	grund_t *from = welt->lookup(pos_next);
@@ -56,6 +56,7 @@ public:
 	void info(cbuffer_t & buf) const OVERRIDE;
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE;
 
 	///@ returns true if pedestrian walks on the left side of the road
 	bool is_on_left() const { return on_left; }
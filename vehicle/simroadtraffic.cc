@@ -13,6 +13,7 @@
 #include "../simunits.h"
 #include "../simtypes.h"
 #include "../simconvoi.h"
+#include "../simhalt.h"
 
 #include "simroadtraffic.h"
 #ifdef DESTINATION_CITYCARS
@@ -36,6 +37,11 @@
 
 
 #include "../utils/cbuffer_t.h"
+#include "../simmem.h"
+
+#ifdef MULTI_THREAD
+#include "../utils/simthread.h"
+#endif
 
 /**********************************************************************************************************************/
 /* Road users (private cars and pedestrians) basis class from here on */
@@ -308,6 +314,75 @@ bool private_car_t::list_empty()
 }
 
 
+/* The map is divided into square cells of citycar_detail_distance tiles.
+ * A cell is detailed, if it or one of its neighbours contains a halt or a convoy,
+ * so all tiles closer than citycar_detail_distance to them are detailed.
+ */
+static vector_tpl<uint8> detailed_cells;
+static sint16 detail_cell_size = 0;
+static sint16 detail_cells_x = 0;
+static sint16 detail_cells_y = 0;
+
+
+void private_car_t::update_detail_map(karte_t *welt)
+{
+	detail_cell_size = welt->get_settings().get_citycar_detail_distance();
+	detailed_cells.clear();
+	if(  detail_cell_size == 0  ) {
+		return;
+	}
+	detail_cells_x = (welt->get_size().x + detail_cell_size - 1) / detail_cell_size;
+	detail_cells_y = (welt->get_size().y + detail_cell_size - 1) / detail_cell_size;
+	const uint32 count = (uint32)detail_cells_x * detail_cells_y;
+
+	// first the cells with halts or convoys
+	vector_tpl<uint8> active( count );
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		active.append( 0 );
+	}
+	FOR(vector_tpl<halthandle_t>, const halt, haltestelle_t::get_alle_haltestellen()) {
+		FOR(slist_tpl<haltestelle_t::tile_t>, const& tile, halt->get_tiles()) {
+			const koord k = tile.grund->get_pos().get_2d();
+			active[ (k.y / detail_cell_size) * detail_cells_x + k.x / detail_cell_size ] = 1;
+		}
+	}
+	FOR(vector_tpl<convoihandle_t>, const cnv, welt->convoys()) {
+		const koord k = cnv->get_pos().get_2d();
+		if(  welt->is_within_limits( k )  ) {
+			active[ (k.y / detail_cell_size) * detail_cells_x + k.x / detail_cell_size ] = 1;
+		}
+	}
+
+	// then also their neighbours
+	detailed_cells.resize( count );
+	for(  sint16 y = 0;  y < detail_cells_y;  y++  ) {
+		for(  sint16 x = 0;  x < detail_cells_x;  x++  ) {
+			uint8 detailed = 0;
+			for(  sint16 ny = max(y-1, 0);  !detailed  &&  ny <= min(y+1, detail_cells_y-1);  ny++  ) {
+				for(  sint16 nx = max(x-1, 0);  !detailed  &&  nx <= min(x+1, detail_cells_x-1);  nx++  ) {
+					detailed = active[ ny * detail_cells_x + nx ];
+				}
+			}
+			detailed_cells.append( detailed );
+		}
+	}
+}
+
+
+bool private_car_t::is_detailed(koord k)
+{
+	if(  detail_cell_size == 0  ) {
+		return true;
+	}
+	const sint16 x = k.x / detail_cell_size;
+	const sint16 y = k.y / detail_cell_size;
+	if(  k.x < 0  ||  k.y < 0  ||  x >= detail_cells_x  ||  y >= detail_cells_y  ) {
+		return true;
+	}
+	return detailed_cells[ y * detail_cells_x + x ] != 0;
+}
+
+
 
 private_car_t::~private_car_t()
 {
@@ -328,6 +403,65 @@ private_car_t::~private_car_t()
 }
 
 
+/* Citycars are too large for the freelist, but there can be a lot of them
+ * and they are created and deleted all the time. So they are kept in chunks
+ * of their own, which are never returned (like the freelist does).
+ */
+#define CITYCAR_CHUNK_SIZE (256)
+
+struct citycar_node_t
+{
+	citycar_node_t *next;
+};
+
+static citycar_node_t *citycar_free_nodes = NULL;
+
+#ifdef MULTI_THREAD
+static pthread_mutex_t citycar_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+void *private_car_t::operator new(size_t s)
+{
+	assert( s == sizeof(private_car_t) );
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &citycar_pool_mutex );
+#endif
+	if(  citycar_free_nodes == NULL  ) {
+		// allocate a new chunk and chain its nodes
+		char *chunk = MALLOCN( char, s*CITYCAR_CHUNK_SIZE );
+		for(  int i=CITYCAR_CHUNK_SIZE-1;  i>=0;  i--  ) {
+			citycar_node_t *node = (citycar_node_t *)(chunk + i*s);
+			node->next = citycar_free_nodes;
+			citycar_free_nodes = node;
+		}
+	}
+	citycar_node_t *node = citycar_free_nodes;
+	citycar_free_nodes = node->next;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &citycar_pool_mutex );
+#endif
+	return node;
+}
+
+
+void private_car_t::operator delete(void *p)
+{
+	if(  p == NULL  ) {
+		return;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &citycar_pool_mutex );
+#endif
+	citycar_node_t *node = (citycar_node_t *)p;
+	node->next = citycar_free_nodes;
+	citycar_free_nodes = node;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &citycar_pool_mutex );
+#endif
+}
+
+
 private_car_t::private_car_t(loadsave_t *file) :
 	road_user_t()
 {
@@ -435,6 +569,34 @@ sync_result private_car_t::sync_step(uint32 delta_t)
 }
 
 
+bool private_car_t::sync_step_local(uint32 delta_t, sync_result &result)
+{
+	if(  time_to_life > (sint32)delta_t  ) {
+		if(  current_speed==0  ) {
+			if(  (ms_traffic_jam>>10) != ((ms_traffic_jam+delta_t)>>10)  ) {
+				// will check the road ahead
+				return false;
+			}
+		}
+		else if(  grund_t* gr = welt->lookup(get_pos())  ) {
+			// same speed as sync_step() will calculate
+			const uint16 old_speed = current_speed;
+			calc_current_speed(gr, delta_t);
+			const bool hop = will_hop( weg_next + current_speed*delta_t );
+			current_speed = old_speed;
+			if(  hop  ) {
+				return false;
+			}
+		}
+		else if(  will_hop( weg_next + current_speed*delta_t )  ) {
+			return false;
+		}
+	}
+	result = sync_step( delta_t );
+	return true;
+}
+
+
 void private_car_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t s( file, "stadtauto_t" );
@@ -1088,6 +1250,10 @@ void private_car_t::enter_tile(grund_t* gr)
 	calc_disp_lane();
 	strasse_t* str = (strasse_t*) gr->get_weg(road_wt);
 	str->book(1, WAY_STAT_CONVOIS, enter_direction);
+	if(  !is_detailed( gr->get_pos().get_2d() )  ) {
+		// far from halts and convoys => only counted from here on
+		time_to_life = 0;
+	}
 	update_tiles_overtaking();
 	if(  next_lane==1  ) {
 		set_tiles_overtaking(3);
@@ -1253,7 +1419,7 @@ koord3d private_car_t::find_destination(uint8 target_index) {
 				bool pos_added = false;
 				// we prefer vacant road.
 				for(  uint8 pos=1;  pos<(volatile uint8)to->get_top();  pos++  ) {
-					vehicle_base_t* const v = dynamic_cast<vehicle_base_t*>(to->obj_bei(pos));
+					vehicle_base_t* const v = obj_cast<vehicle_base_t>(to->obj_bei(pos));
 					if(  v  &&  v->is_stuck()  ) {
 						// there is a stucked car on the tile. reduce possibility.
 						poslist.append(to->get_pos(), rp.weight_crowded);
@@ -1776,41 +1942,36 @@ vehicle_base_t* private_car_t::is_there_car (grund_t *gr) const
 	if(  !str  ||  (str->get_overtaking_mode()>=twoway_mode  &&  str->get_overtaking_mode()<inverted_mode)  ) {
 		return NULL;
 	}
-	for(  uint8 pos=1;  pos<(volatile uint8)gr->get_top();  pos++  ) {
-		if(  vehicle_base_t* const v = obj_cast<vehicle_base_t>(gr->obj_bei(pos))  ) {
-			if(  v->get_typ()==obj_t::pedestrian  ) {
+	FOR(vector_tpl<vehicle_base_t *>, const v, str->get_vehicles(gr)) {
+		if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
+			if(  is_overtaking() && at->get_convoi()->is_overtaking()  ){
 				continue;
 			}
-			if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
-				if(  is_overtaking() && at->get_convoi()->is_overtaking()  ){
-					continue;
+			if(  !is_overtaking() && !(at->get_convoi()->is_overtaking())  ){
+				//Prohibit going on passing lane when facing traffic exists.
+				ribi_t::ribi other_direction = at->get_direction();
+				if(  ribi_t::backward(get_direction()) == other_direction  ) {
+					return v;
 				}
-				if(  !is_overtaking() && !(at->get_convoi()->is_overtaking())  ){
-					//Prohibit going on passing lane when facing traffic exists.
-					ribi_t::ribi other_direction = at->get_direction();
-					if(  ribi_t::backward(get_direction()) == other_direction  ) {
-						return v;
-					}
-					continue;
-				}
-				// speed zero check must be done by parent function.
-				return v;
+				continue;
 			}
-			else if(  private_car_t* const caut = obj_cast<private_car_t>(v)  ) {
-				if(  is_overtaking() && caut->is_overtaking()  ){
-					continue;
-				}
-				if(  !is_overtaking() && !(caut->is_overtaking())  ){
-					//Prohibit going on passing lane when facing traffic exists.
-					ribi_t::ribi other_direction = caut->get_direction();
-					if(  ribi_t::backward(get_direction()) == other_direction  ) {
-						return v;
-					}
-					continue;
+			// speed zero check must be done by parent function.
+			return v;
+		}
+		else if(  private_car_t* const caut = obj_cast<private_car_t>(v)  ) {
+			if(  is_overtaking() && caut->is_overtaking()  ){
+				continue;
+			}
+			if(  !is_overtaking() && !(caut->is_overtaking())  ){
+				//Prohibit going on passing lane when facing traffic exists.
+				ribi_t::ribi other_direction = caut->get_direction();
+				if(  ribi_t::backward(get_direction()) == other_direction  ) {
+					return v;
 				}
-				// speed zero check must be done by parent function.
-				return v;
+				continue;
 			}
+			// speed zero check must be done by parent function.
+			return v;
 		}
 	}
 	return NULL;
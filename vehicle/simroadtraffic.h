@@ -138,11 +138,16 @@ public:
 
 	virtual ~private_car_t();
 
+	// citycars are allocated from a pool of their own
+	void * operator new(size_t s);
+	void operator delete(void *p);
+
 	void rotate90() OVERRIDE;
 
 	const citycar_desc_t *get_desc() const { return desc; }
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	bool sync_step_local(uint32 delta_t, sync_result &result) OVERRIDE;
 
 	void hop(grund_t *gr) OVERRIDE;
 	bool ist_weg_frei(grund_t *gr);
@@ -175,6 +180,15 @@ public:
 	static bool register_desc(const citycar_desc_t *desc);
 	static bool successfully_loaded();
 
+	/**
+	 * Marks where citycars are simulated: near halts and convoys, see settings_t::get_citycar_detail_distance().
+	 * Called each step, so it is the same on all clients.
+	 */
+	static void update_detail_map(karte_t *welt);
+
+	/// false, if citycars at @p k are only counted
+	static bool is_detailed(koord k);
+
 	// since we must consider overtaking, we use this for offset calculation
 	void get_screen_offset( int &xoff, int &yoff, const sint16 raster_width, bool prev_based ) const;
 	virtual void get_screen_offset( int &xoff, int &yoff, const sint16 raster_width ) const OVERRIDE{ get_screen_offset(xoff,yoff,raster_width,false); }
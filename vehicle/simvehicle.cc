@@ -530,84 +530,82 @@ vehicle_base_t *vehicle_base_t::no_cars_blocking( const grund_t *gr, const convo
 		cnv_overtaking = false; //treated as convoi is not
 		break;
 	}
+	const strasse_t *str = (const strasse_t *)gr->get_weg(road_wt);
+	if(  str == NULL  ) {
+		return NULL;
+	}
 	// Search vehicle
-	for(  uint8 pos=1;  pos<(uint8)gr->get_top();  pos++  ) {
-		if(  vehicle_base_t* const v = obj_cast<vehicle_base_t>(gr->obj_bei(pos))  ) {
-			if(  v->get_typ()==obj_t::pedestrian  ) {
+	FOR(vector_tpl<vehicle_base_t *>, const v, str->get_vehicles(gr)) {
+		// check for car
+		uint8 other_direction=255;
+		bool other_moving = false;
+		bool other_overtaking = false; //whether the other convoi is on passing lane.
+		if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
+			// ignore ourself
+			if(  cnv == at->get_convoi()  ) {
 				continue;
 			}
-
-			// check for car
-			uint8 other_direction=255;
-			bool other_moving = false;
-			bool other_overtaking = false; //whether the other convoi is on passing lane.
-			if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
-				// ignore ourself
-				if(  cnv == at->get_convoi()  ) {
-					continue;
-				}
-				other_direction = at->get_direction();
-				other_moving = at->get_convoi()->get_akt_speed() > kmh_to_speed(1);
-				other_overtaking = at->get_convoi()->is_overtaking();
-			}
-			// check for city car
-			else if(  v->get_waytype() == road_wt  ) {
-				other_direction = v->get_direction();
-				if(  private_car_t const* const sa = obj_cast<private_car_t>(v)  ){
-					if(  pcar == sa  ) {
-						continue; // ignore ourself
-					}
-					other_moving = sa->get_current_speed() > 1;
-					other_overtaking = sa->is_overtaking();
+			other_direction = at->get_direction();
+			other_moving = at->get_convoi()->get_akt_speed() > kmh_to_speed(1);
+			other_overtaking = at->get_convoi()->is_overtaking();
+		}
+		// check for city car
+		else if(  v->get_waytype() == road_wt  ) {
+			other_direction = v->get_direction();
+			if(  private_car_t const* const sa = obj_cast<private_car_t>(v)  ){
+				if(  pcar == sa  ) {
+					continue; // ignore ourself
 				}
+				other_moving = sa->get_current_speed() > 1;
+				other_overtaking = sa->is_overtaking();
 			}
+		}
 
-			// ok, there is another car ...
-			if(  other_direction != 255  ) {
-				if(  next_direction == other_direction  &&  !ribi_t::is_threeway(gr->get_weg_ribi(road_wt))  &&  cnv_overtaking == other_overtaking  ) {
-					// only consider cars on same lane.
-					// cars going in the same direction and no crossing => that mean blocking ...
-					return v;
-				}
-
-				const ribi_t::ribi other_90direction = (gr->get_pos().get_2d() == v->get_pos_next().get_2d()) ? other_direction : calc_direction(gr->get_pos(), v->get_pos_next());
-				if(  other_90direction == next_90direction   &&  cnv_overtaking == other_overtaking  ) {
-					// Want to exit in same as other   ~50% of the time
-					return v;
-				}
+		// ok, there is another car ...
+		if(  other_direction != 255  ) {
+			if(  next_direction == other_direction  &&  !ribi_t::is_threeway(gr->get_weg_ribi(road_wt))  &&  cnv_overtaking == other_overtaking  ) {
+				// only consider cars on same lane.
+				// cars going in the same direction and no crossing => that mean blocking ...
+				return v;
+			}
 
-				const bool drives_on_left = welt->get_settings().is_drive_left();
-				const bool across = next_direction == (drives_on_left ? ribi_t::rotate45l(next_90direction) : ribi_t::rotate45(next_90direction)); // turning across the opposite directions lane
-				const bool other_across = other_direction == (drives_on_left ? ribi_t::rotate45l(other_90direction) : ribi_t::rotate45(other_90direction)); // other is turning across the opposite directions lane
-				if(  other_direction == next_direction  &&  !(other_across || across)  &&  cnv_overtaking == other_overtaking) {
-					// only consider cars on same lane.
-					// entering same straight waypoint as other ~18%
-					return v;
-				}
+			const ribi_t::ribi other_90direction = (gr->get_pos().get_2d() == v->get_pos_next().get_2d()) ? other_direction : calc_direction(gr->get_pos(), v->get_pos_next());
+			if(  other_90direction == next_90direction   &&  cnv_overtaking == other_overtaking  ) {
+				// Want to exit in same as other   ~50% of the time
+				return v;
+			}
 
-				const bool straight = next_direction == next_90direction; // driving straight
-				const ribi_t::ribi current_90direction = straight ? ribi_t::backward(next_90direction) : (~(next_direction|ribi_t::backward(next_90direction)))&0x0F;
-				const bool other_straight = other_direction == other_90direction; // other is driving straight
-				const bool other_exit_same_side = current_90direction == other_90direction; // other is exiting same side as we're entering
-				const bool other_exit_opposite_side = ribi_t::backward(current_90direction) == other_90direction; // other is exiting side across from where we're entering
-				if(  across  &&  ((ribi_t::is_perpendicular(current_90direction,other_direction)  &&  other_moving)  ||  (other_across  &&  other_exit_opposite_side)  ||  ((other_across  ||  other_straight)  &&  other_exit_same_side  &&  other_moving) ) )  {
-					// other turning across in front of us from orth entry dir'n   ~4%
-					return v;
-				}
+			const bool drives_on_left = welt->get_settings().is_drive_left();
+			const bool across = next_direction == (drives_on_left ? ribi_t::rotate45l(next_90direction) : ribi_t::rotate45(next_90direction)); // turning across the opposite directions lane
+			const bool other_across = other_direction == (drives_on_left ? ribi_t::rotate45l(other_90direction) : ribi_t::rotate45(other_90direction)); // other is turning across the opposite directions lane
+			if(  other_direction == next_direction  &&  !(other_across || across)  &&  cnv_overtaking == other_overtaking) {
+				// only consider cars on same lane.
+				// entering same straight waypoint as other ~18%
+				return v;
+			}
 
-				const bool headon = ribi_t::backward(current_direction) == other_direction; // we're meeting the other headon
-				const bool other_exit_across = (drives_on_left ? ribi_t::rotate90l(next_90direction) : ribi_t::rotate90(next_90direction)) == other_90direction; // other is exiting by turning across the opposite directions lane
-				if(  straight  &&  (ribi_t::is_perpendicular(current_90direction,other_direction)  ||  (other_across  &&  other_moving  &&  (other_exit_across  ||  (other_exit_same_side  &&  !headon))) ) ) {
-					// other turning across in front of us, but allow if other is stopped - duplicating historic behaviour   ~2%
-					return v;
-				}
-				else if(  other_direction == current_direction  &&  current_90direction == ribi_t::none  &&  cnv_overtaking == other_overtaking  ) {
-					// entering same diagonal waypoint as other   ~1%
-					return v;
-				}
+			const bool straight = next_direction == next_90direction; // driving straight
+			const ribi_t::ribi current_90direction = straight ? ribi_t::backward(next_90direction) : (~(next_direction|ribi_t::backward(next_90direction)))&0x0F;
+			const bool other_straight = other_direction == other_90direction; // other is driving straight
+			const bool other_exit_same_side = current_90direction == other_90direction; // other is exiting same side as we're entering
+			const bool other_exit_opposite_side = ribi_t::backward(current_90direction) == other_90direction; // other is exiting side across from where we're entering
+			if(  across  &&  ((ribi_t::is_perpendicular(current_90direction,other_direction)  &&  other_moving)  ||  (other_across  &&  other_exit_opposite_side)  ||  ((other_across  ||  other_straight)  &&  other_exit_same_side  &&  other_moving) ) )  {
+				// other turning across in front of us from orth entry dir'n   ~4%
+				return v;
+			}
 
-				// else other car is not blocking   ~25%
+			const bool headon = ribi_t::backward(current_direction) == other_direction; // we're meeting the other headon
+			const bool other_exit_across = (drives_on_left ? ribi_t::rotate90l(next_90direction) : ribi_t::rotate90(next_90direction)) == other_90direction; // other is exiting by turning across the opposite directions lane
+			if(  straight  &&  (ribi_t::is_perpendicular(current_90direction,other_direction)  ||  (other_across  &&  other_moving  &&  (other_exit_across  ||  (other_exit_same_side  &&  !headon))) ) ) {
+				// other turning across in front of us, but allow if other is stopped - duplicating historic behaviour   ~2%
+				return v;
+			}
+			else if(  other_direction == current_direction  &&  current_90direction == ribi_t::none  &&  cnv_overtaking == other_overtaking  ) {
+				// entering same diagonal waypoint as other   ~1%
+				return v;
 			}
+
+			// else other car is not blocking   ~25%
 		}
 	}
 
@@ -805,7 +803,7 @@ uint16 vehicle_t::unload_cargo(halthandle_t halt, bool unload_all )
  * Load freight from halt
  * @return amount loaded
  */
-uint16 vehicle_t::load_cargo(halthandle_t halt, const vector_tpl<halthandle_t>& destination_halts)
+uint16 vehicle_t::load_cargo(halthandle_t halt, const vector_tpl<halthandle_t>& destination_halts, loading_plan_t &plan)
 {
 	if(  !halt.is_bound()  ||  !halt->gibt_ab(desc->get_freight_type())  ) {
 		return 0;
@@ -816,7 +814,7 @@ uint16 vehicle_t::load_cargo(halthandle_t halt, const vector_tpl<halthandle_t>&
 	if (capacity_left > 0) {
 
 		slist_tpl<ware_t> freight_add;
-		halt->fetch_goods( freight_add, desc->get_freight_type(), capacity_left, destination_halts);
+		halt->fetch_goods( freight_add, desc->get_freight_type(), capacity_left, destination_halts, plan);
 
 		if(  freight_add.empty()  ) {
 			// now empty, but usually, we can get it here ...
@@ -1045,7 +1043,11 @@ vehicle_t::vehicle_t() :
 
 bool vehicle_t::calc_route(koord3d start, koord3d ziel, sint32 max_speed, route_t* route)
 {
-	return route->calc_route(welt, start, ziel, this, max_speed, 0 );
+	route_t::route_result_t r;
+	if(  cnv  &&  cnv->take_prepared_route( start, ziel, max_speed, route, r )  ) {
+		return r;
+	}
+	return route->calc_route(welt, start, ziel, this, max_speed, get_route_halt_length() );
 }
 
 
@@ -2057,6 +2059,12 @@ void road_vehicle_t::rotate90()
 }
 
 
+sint32 road_vehicle_t::get_route_halt_length() const
+{
+	return cnv->get_tile_length();
+}
+
+
 void road_vehicle_t::calc_disp_lane()
 {
 	// driving in the back or the front
@@ -2076,7 +2084,10 @@ bool road_vehicle_t::calc_route(koord3d start, koord3d ziel, sint32 max_speed, r
 		}
 	}
 	target_halt = halthandle_t(); // no block reserved
-	route_t::route_result_t r = route->calc_route(welt, start, ziel, this, max_speed, cnv->get_tile_length() );
+	route_t::route_result_t r;
+	if(  !cnv->take_prepared_route( start, ziel, max_speed, route, r )  ) {
+		r = route->calc_route(welt, start, ziel, this, max_speed, get_route_halt_length() );
+	}
 	if(  r == route_t::valid_route_halt_too_short  ) {
 		cbuffer_t buf;
 		buf.printf( translator::translate("Vehicle %s cannot choose because stop too short!"), cnv->get_name());
@@ -2937,51 +2948,46 @@ vehicle_base_t* road_vehicle_t::other_lane_blocked(const bool only_search_top, s
 
 			bool ignore_stucked = !only_search_top  &&  test_index==end_index;
 
-			for(  uint8 pos=1;  pos<(volatile uint8)gr->get_top();  pos++  ) {
-				if(  vehicle_base_t* const v = obj_cast<vehicle_base_t>(gr->obj_bei(pos))  ) {
-					if(  v->get_typ()==obj_t::pedestrian  ) {
+			FOR(vector_tpl<vehicle_base_t *>, const v, str->get_vehicles(gr)) {
+				if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
+					// ignore ourself
+					if(  cnv == at->get_convoi()  ) {
 						continue;
 					}
-					if(  road_vehicle_t const* const at = obj_cast<road_vehicle_t>(v)  ) {
-						// ignore ourself
-						if(  cnv == at->get_convoi()  ) {
-							continue;
-						}
-						if(  cnv->is_overtaking() == at->get_convoi()->is_overtaking()  ){
-							continue;
-						}
-						// Ignore stopping convoi on the tile behind this convoi to change lane in traffic jam.
-						if(  ignore_stucked  &&  at->get_convoi()->get_akt_speed() == 0  ) {
-							continue;
-						}
-						if(  test_index==tail_index-1+offset  ||  test_index==tail_index+offset  ){
-							uint8 tail_offset = 0;
-							if(  test_index==tail_index-1+offset  ) tail_offset = 1;
-							if(  test_index+tail_offset>=1  &&  test_index+tail_offset<(sint32)r.get_count()-1  &&   judge_lane_crossing(calc_direction(r.at(test_index-1u+tail_offset),r.at(test_index+tail_offset)), calc_direction(r.at(test_index+tail_offset),r.at(test_index+1u+tail_offset)),  v->get_90direction(), cnv->is_overtaking(), true)  ){
-								return v;
-							}
-							continue;
-						}
-						return v;
+					if(  cnv->is_overtaking() == at->get_convoi()->is_overtaking()  ){
+						continue;
 					}
-					else if(  private_car_t* const caut = obj_cast<private_car_t>(v)  ) {
-						if(  cnv->is_overtaking() == caut->is_overtaking()  ){
-							continue;
-						}
-						// Ignore stopping convoi on the tile behind this convoi to change lane in traffic jam.
-						if(  ignore_stucked  &&  caut->get_current_speed() == 0  ) {
-							continue;
+					// Ignore stopping convoi on the tile behind this convoi to change lane in traffic jam.
+					if(  ignore_stucked  &&  at->get_convoi()->get_akt_speed() == 0  ) {
+						continue;
+					}
+					if(  test_index==tail_index-1+offset  ||  test_index==tail_index+offset  ){
+						uint8 tail_offset = 0;
+						if(  test_index==tail_index-1+offset  ) tail_offset = 1;
+						if(  test_index+tail_offset>=1  &&  test_index+tail_offset<(sint32)r.get_count()-1  &&   judge_lane_crossing(calc_direction(r.at(test_index-1u+tail_offset),r.at(test_index+tail_offset)), calc_direction(r.at(test_index+tail_offset),r.at(test_index+1u+tail_offset)),  v->get_90direction(), cnv->is_overtaking(), true)  ){
+							return v;
 						}
-						if(  test_index==tail_index-1+offset  ||  test_index==tail_index+offset  ){
-							uint8 tail_offset = 0;
-							if(  test_index==tail_index-1+offset  ) tail_offset = 1;
-							if(  test_index+tail_offset>=1  &&  test_index+tail_offset<(sint32)r.get_count()-1  &&   judge_lane_crossing(calc_direction(r.at(test_index-1u+tail_offset),r.at(test_index+tail_offset)), calc_direction(r.at(test_index+tail_offset),r.at(test_index+1u+tail_offset)),  v->get_90direction(), cnv->is_overtaking(), true)  ){
-								return v;
-							}
-							continue;
+						continue;
+					}
+					return v;
+				}
+				else if(  private_car_t* const caut = obj_cast<private_car_t>(v)  ) {
+					if(  cnv->is_overtaking() == caut->is_overtaking()  ){
+						continue;
+					}
+					// Ignore stopping convoi on the tile behind this convoi to change lane in traffic jam.
+					if(  ignore_stucked  &&  caut->get_current_speed() == 0  ) {
+						continue;
+					}
+					if(  test_index==tail_index-1+offset  ||  test_index==tail_index+offset  ){
+						uint8 tail_offset = 0;
+						if(  test_index==tail_index-1+offset  ) tail_offset = 1;
+						if(  test_index+tail_offset>=1  &&  test_index+tail_offset<(sint32)r.get_count()-1  &&   judge_lane_crossing(calc_direction(r.at(test_index-1u+tail_offset),r.at(test_index+tail_offset)), calc_direction(r.at(test_index+tail_offset),r.at(test_index+1u+tail_offset)),  v->get_90direction(), cnv->is_overtaking(), true)  ){
+							return v;
 						}
-						return v;
+						continue;
 					}
+					return v;
 				}
 			}
 			if(  only_search_top  ) {
@@ -3156,6 +3162,8 @@ road_vehicle_t::~road_vehicle_t() {
 /* from now on rail vehicles (and other vehicles using blocks) */
 rail_vehicle_t::rail_vehicle_t(loadsave_t *file, bool is_first, bool is_last) : vehicle_t()
 {
+	route_ways_deleted_count = 0;
+	ignore_reservations = false;
 	vehicle_t::rdwr_from_convoi(file);
 
 	if(  file->is_loading()  ) {
@@ -3201,6 +3209,8 @@ rail_vehicle_t::rail_vehicle_t(koord3d pos, const vehicle_desc_t* desc, player_t
 	vehicle_t(pos, desc, player)
 {
 	cnv = cn;
+	route_ways_deleted_count = 0;
+	ignore_reservations = false;
 }
 
 
@@ -3273,8 +3283,17 @@ bool rail_vehicle_t::calc_route(koord3d start, koord3d ziel, sint32 max_speed, r
 	}
 	cnv->set_next_reservation_index( 0 );	// nothing to reserve
 	target_halt = halthandle_t();	// no block reserved
-	uint16 len = welt->get_settings().get_advance_to_end() ? 8888 : cnv->get_tile_length(true);
-	return route->calc_route(welt, start, ziel, this, max_speed, len);
+	route_t::route_result_t r;
+	if(  cnv->take_prepared_route( start, ziel, max_speed, route, r )  ) {
+		return r;
+	}
+	return route->calc_route(welt, start, ziel, this, max_speed, get_route_halt_length());
+}
+
+
+sint32 rail_vehicle_t::get_route_halt_length() const
+{
+	return welt->get_settings().get_advance_to_end() ? 8888 : cnv->get_tile_length(true);
 }
 
 
@@ -3329,7 +3348,7 @@ bool rail_vehicle_t::check_next_tile(const grund_t *bd, bool coupling) const
 		}
 		// but we can only use empty blocks ...
 		// now check, if we could enter here
-		if(  sch->can_reserve(cnv->self)  ) {
+		if(  ignore_reservations  ||  sch->can_reserve(cnv->self)  ) {
 			return true;
 		}
 		if(  coupling  ) {
@@ -3355,6 +3374,24 @@ bool rail_vehicle_t::check_next_tile(const grund_t *bd, bool coupling) const
 }
 
 
+uint64 rail_vehicle_t::get_driver_id() const
+{
+	return ((uint64)(uint32)cnv->get_min_top_speed() << 32) | ((uint32)desc->get_waytype() << 16) | ((uint32)(uint8)get_owner_nr() << 8) | (cnv->needs_electrification() ? 1 : 0);
+}
+
+
+// what check_next_tile() depends on besides the ways
+bool rail_vehicle_t::get_route_cache_id(uint64 &id) const
+{
+	if(  cnv == NULL  ||  target_halt.is_bound()  ) {
+		// searching a free stop depends on the reservations
+		return false;
+	}
+	id = get_driver_id();
+	return true;
+}
+
+
 // how expensive to go here (for way search)
 int rail_vehicle_t::get_cost(const grund_t *gr, const weg_t *w, const sint32 max_speed, ribi_t::ribi from) const
 {
@@ -3384,7 +3421,7 @@ bool rail_vehicle_t::is_target(const grund_t *gr,const grund_t *prev_gr) const
 {
 	const schiene_t * sch1 = (const schiene_t *) gr->get_weg(get_waytype());
 	// first check blocks, if we can go there
-	if(  sch1->can_reserve(cnv->self)  ) {
+	if(  ignore_reservations  ||  sch1->can_reserve(cnv->self)  ) {
 		//  just check, if we reached a free stop position of this halt
 		if(  gr->is_halt()  &&  gr->get_halt()==target_halt  ) {
 			// now we must check the predecessor ...
@@ -3690,7 +3727,7 @@ skip_choose:
 			route_found = target_rt.find_route( welt, cnv->get_route()->at(start_block), this, speed_to_kmh(cnv->get_min_top_speed()), richtung, welt->get_settings().get_max_choose_route_steps(), true );
 		}
 		if(  !route_found  &&  (!sig->is_guide_signal()  ||  !try_coupling)  ) {
-			route_found = target_rt.find_route( welt, cnv->get_route()->at(start_block), this, speed_to_kmh(cnv->get_min_top_speed()), richtung, welt->get_settings().get_max_choose_route_steps(), false );
+			route_found = find_free_stop_route( target_rt, cnv->get_route()->at(start_block), richtung );
 			try_coupling = false;
 		}
 		if(  !route_found  ) {
@@ -3741,6 +3778,116 @@ skip_choose:
 }
 
 
+// stop positions of a halt in reach of a choose signal, with the shortest route to each ignoring reservations
+struct choose_route_cache_t
+{
+	koord3d start;
+	ribi_t::ribi dir;
+	halthandle_t halt;
+	uint64 driver_id;
+	uint32 max_depth;
+	uint16 tile_length;
+	/// weg_t::get_generation() of the waytype when searched, outdated if different
+	uint32 generation;
+	/// cheapest first, empty if no stop position is in reach
+	vector_tpl<koord3d_vector_t *> candidates;
+
+	~choose_route_cache_t()
+	{
+		FOR(vector_tpl<koord3d_vector_t *>, const r, candidates) {
+			delete r;
+		}
+	}
+};
+
+// most recently used last
+static vector_tpl<choose_route_cache_t *> choose_route_cache;
+#define MAX_CHOOSE_ROUTE_CACHE (256)
+
+
+bool rail_vehicle_t::find_free_stop_route(route_t &target_rt, koord3d start, ribi_t::ribi dir)
+{
+	const uint32 max_depth = welt->get_settings().get_max_choose_route_steps();
+	if(  env_t::networkmode  ) {
+		// the cache is not saved => not the same on all clients
+		return target_rt.find_route( welt, start, this, speed_to_kmh(cnv->get_min_top_speed()), dir, max_depth, false );
+	}
+
+	const uint32 generation = weg_t::get_generation( get_waytype() );
+	const uint64 driver_id = get_driver_id();
+	const uint16 tile_length = cnv->get_tile_length(true);
+	choose_route_cache_t *cached = NULL;
+	for(  uint32 i = choose_route_cache.get_count();  i-- > 0;  ) {
+		choose_route_cache_t *e = choose_route_cache[i];
+		if(  e->start == start  &&  e->dir == dir  &&  e->halt == target_halt  &&  e->driver_id == driver_id  &&  e->max_depth == max_depth  &&  e->tile_length == tile_length  ) {
+			choose_route_cache.remove_at( i );
+			if(  e->generation == generation  ) {
+				// used again => move to the end
+				choose_route_cache.append( e );
+				cached = e;
+			}
+			else {
+				// ways, signs or signals have changed since
+				delete e;
+			}
+			break;
+		}
+	}
+
+	if(  cached == NULL  ) {
+		if(  choose_route_cache.get_count() >= MAX_CHOOSE_ROUTE_CACHE  ) {
+			// drop the least recently used
+			delete choose_route_cache[0];
+			choose_route_cache.remove_at( 0 );
+		}
+		cached = new choose_route_cache_t();
+		cached->start = start;
+		cached->dir = dir;
+		cached->halt = target_halt;
+		cached->driver_id = driver_id;
+		cached->max_depth = max_depth;
+		cached->tile_length = tile_length;
+		cached->generation = generation;
+		choose_route_cache.append( cached );
+
+		ignore_reservations = true;
+		target_rt.find_all_routes( welt, start, this, speed_to_kmh(cnv->get_min_top_speed()), dir, max_depth, cached->candidates );
+		ignore_reservations = false;
+	}
+
+	if(  cached->candidates.empty()  ) {
+		// not even without reservations
+		return false;
+	}
+
+	// the ways are unchanged, so only the reservations can block a candidate
+	FOR(vector_tpl<koord3d_vector_t *>, const candidate, cached->candidates) {
+		const koord3d_vector_t &tiles = *candidate;
+		bool free = true;
+		const grund_t *prev = NULL;
+		for(  uint32 i = 0;  free  &&  i < tiles.get_count();  i++  ) {
+			const grund_t *gr = welt->lookup( tiles[i] );
+			// as in route_t::find_route()
+			free = gr  &&  (i==0 ? check_next_tile( gr ) : check_next_tile( gr, true ));
+			if(  free  &&  i+1 == tiles.get_count()  ) {
+				free = is_target( gr, prev );
+			}
+			prev = gr;
+		}
+		if(  free  ) {
+			target_rt.clear();
+			FOR(koord3d_vector_t, const& k, tiles) {
+				target_rt.append( k );
+			}
+			return true;
+		}
+	}
+
+	// all shortest routes are blocked, maybe a detour reaches a free stop position
+	return target_rt.find_route( welt, start, this, speed_to_kmh(cnv->get_min_top_speed()), dir, max_depth, false );
+}
+
+
 bool rail_vehicle_t::is_pre_signal_clear(signal_t *sig, uint16 next_block, sint32 &restart_speed)
 {
 	// parse to next signal; if needed recurse, since we allow cascading
@@ -4022,13 +4169,40 @@ bool rail_vehicle_t::can_enter_tile(const grund_t *gr, sint32 &restart_speed, ui
  * if (!reserve && force_unreserve) then un-reserve everything till the end of the route
  * return the last checked block
  */
+schiene_t *rail_vehicle_t::get_route_way(const route_t *route, uint16 i) const
+{
+	if(  route_ways_deleted_count != schiene_t::deleted_count  ) {
+		// rails were removed => cached pointers may be dangling
+		route_ways.clear();
+		route_ways_deleted_count = schiene_t::deleted_count;
+	}
+	const koord3d pos = route->at(i);
+	if(  i < route_ways.get_count()  &&  route_ways[i].pos == pos  &&  route_ways[i].way  ) {
+		return route_ways[i].way;
+	}
+	grund_t *gr = welt->lookup(pos);
+	schiene_t *sch = gr ? (schiene_t *)gr->get_weg(get_waytype()) : NULL;
+	if(  sch  ) {
+		while(  route_ways.get_count() <= i  ) {
+			route_way_t empty;
+			empty.pos = koord3d::invalid;
+			empty.way = NULL;
+			route_ways.append( empty );
+		}
+		route_ways[i].pos = pos;
+		route_ways[i].way = sch;
+	}
+	return sch;
+}
+
+
 bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, uint16 &next_signal_index, uint16 &next_crossing_index, int count, bool reserve, bool force_unreserve, bool use_vector  ) const
 {
 	bool success=true;
 #ifdef MAX_CHOOSE_BLOCK_TILES
 	int max_tiles=2*MAX_CHOOSE_BLOCK_TILES; // max tiles to check for choosesignals
 #endif
-	slist_tpl<grund_t *> signs; // switch all signals on their way too ...
+	vector_tpl<uint16> signs; // switch all signals on their way too ...
 
 	if(start_index>=route->get_count()) {
 		cnv->set_next_reservation_index( max(route->get_count(),1)-1 );
@@ -4051,8 +4225,7 @@ bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, ui
 	for ( ; success  &&  count>=0  &&  i<route->get_count(); i++) {
 
 		koord3d pos = route->at(i);
-		grund_t *gr = welt->lookup(pos);
-		schiene_t * sch1 = gr ? (schiene_t *)gr->get_weg(get_waytype()) : NULL;
+		schiene_t * sch1 = get_route_way(route, i);
 		if(sch1==NULL  &&  reserve) {
 			// reserve until the end of track
 			break;
@@ -4068,7 +4241,7 @@ bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, ui
 		if(reserve) {
 			if(  sch1->has_signal()  &&  i<route->get_count()-1  ) {
 				if(count) {
-					signs.append(gr);
+					signs.append(i);
 				}
 				count --;
 				next_signal_index = i;
@@ -4097,14 +4270,17 @@ bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, ui
 				// If reservation is controlled by next_reservation_index, this does nothing.
 				cnv->unreserve_pos(pos);
 			}
-			if(sch1->has_signal()) {
-				signal_t* signal = gr->find<signal_t>();
-				if(signal) {
-					signal->set_state(roadsign_t::STATE_RED);
+			if(  sch1->has_signal()  ||  sch1->is_crossing()  ) {
+				grund_t *gr = welt->lookup(pos);
+				if(sch1->has_signal()) {
+					signal_t* signal = gr->find<signal_t>();
+					if(signal) {
+						signal->set_state(roadsign_t::STATE_RED);
+					}
+				}
+				if(sch1->is_crossing()) {
+					gr->find<crossing_t>()->release_crossing(this);
 				}
-			}
-			if(sch1->is_crossing()) {
-				gr->find<crossing_t>()->release_crossing(this);
 			}
 		}
 	}
@@ -4120,7 +4296,7 @@ bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, ui
 	if(!success) {
 		// free reservation
 		for ( int j=start_index; j<i; j++) {
-			schiene_t * sch1 = (schiene_t *)welt->lookup( route->at(j))->get_weg(get_waytype());
+			schiene_t * sch1 = get_route_way(route, j);
 			sch1->unreserve(cnv->self);
 			cnv->unreserve_pos(route->at(j));
 		}
@@ -4129,8 +4305,9 @@ bool rail_vehicle_t::block_reserver(const route_t *route, uint16 start_index, ui
 	}
 
 	// ok, switch everything green ...
-	FOR(slist_tpl<grund_t*>, const g, signs) {
-		if (signal_t* const signal = g->find<signal_t>()) {
+	FOR(vector_tpl<uint16>, const idx, signs) {
+		grund_t *gr = welt->lookup(route->at(idx));
+		if (signal_t* const signal = gr ? gr->find<signal_t>() : NULL) {
 			signal->set_state(roadsign_t::STATE_GREEN);
 		}
 	}
@@ -21,8 +21,10 @@
 class convoi_t;
 class schedule_t;
 class signal_t;
+class schiene_t;
 class ware_t;
 class route_t;
+class loading_plan_t;
 
 /*----------------------- Movables ------------------------------------*/
 
@@ -131,6 +133,9 @@ public:
 
 	virtual uint32 do_drive(uint32 dist);	// basis movement code
 
+	/// true, if do_drive(dist) may leave the current tile
+	bool will_hop(uint32 dist) const { return steps + (dist >> YARDS_PER_VEHICLE_STEP_SHIFT) > steps_next; }
+
 	inline void set_image( image_id b ) { image = b; }
 	image_id get_image() const OVERRIDE {return image;}
 
@@ -306,6 +311,11 @@ public:
 	virtual bool calc_route(koord3d start, koord3d ziel, sint32 max_speed, route_t* route);
 	uint16 get_route_index() const {return route_index;}
 
+	/**
+	 * How many tiles of a halt calc_route() should advance into, see route_t::calc_route()
+	 */
+	virtual sint32 get_route_halt_length() const { return 0; }
+
 	/**
 	* Get the base image.
 	*/
@@ -433,9 +443,10 @@ public:
 
 	/**
 	 * Load freight from halt
+	 * @param plan loading order shared by all vehicles of the convoi
 	 * @return amount loaded
 	 */
-	uint16 load_cargo(halthandle_t halt, const vector_tpl<halthandle_t>& destination_halts);
+	uint16 load_cargo(halthandle_t halt, const vector_tpl<halthandle_t>& destination_halts, loading_plan_t &plan);
 
 	/**
 	* Remove freight that no longer can reach it's destination
@@ -519,6 +530,8 @@ public:
 
 	bool calc_route(koord3d start, koord3d ziel, sint32 max_speed, route_t* route) OVERRIDE;
 
+	sint32 get_route_halt_length() const OVERRIDE;
+
 	bool can_enter_tile(const grund_t *gr_next, sint32 &restart_speed, uint8 second_check_count) OVERRIDE;
 
 	// returns true for the way search to an unknown target.
@@ -566,17 +579,47 @@ protected:
 	bool is_longblock_signal_clear(signal_t *sig, uint16 start_index, sint32 &restart_speed);
 	bool is_choose_signal_clear(signal_t *sig, uint16 start_index, sint32 &restart_speed);
 
+	/// rails along the last route reserved, so reserving it again needs no map lookups
+	struct route_way_t
+	{
+		koord3d pos;
+		schiene_t *way;
+	};
+	mutable vector_tpl<route_way_t> route_ways;
+	/// schiene_t::deleted_count when route_ways was filled
+	mutable uint32 route_ways_deleted_count;
+
+	/// @returns the rail at @p route index @p i or NULL
+	schiene_t *get_route_way(const route_t *route, uint16 i) const;
+
+	/// speed, waytype, owner and electrification, on which check_next_tile() depends besides the ways
+	uint64 get_driver_id() const;
+
+	/// check_next_tile() and is_target() treat reserved blocks as free
+	bool ignore_reservations;
+
+	/**
+	 * Finds a route from the choose signal at @p start to a free stop position of target_halt.
+	 * In single player, the stop positions in reach are remembered per signal and halt with the
+	 * shortest route to each, and the cheapest one whose route is free is taken.
+	 */
+	bool find_free_stop_route(route_t &target_rt, koord3d start, ribi_t::ribi dir);
+
 public:
 	waytype_t get_waytype() const OVERRIDE { return track_wt; }
 
 	// since we might need to un-reserve previously used blocks, we must do this before calculation a new route
 	bool calc_route(koord3d start, koord3d ziel, sint32 max_speed, route_t* route) OVERRIDE;
 
+	sint32 get_route_halt_length() const OVERRIDE;
+
 	// how expensive to go here (for way search)
 	int get_cost(const grund_t *gr, const weg_t *w, const sint32 max_speed, ribi_t::ribi from) const OVERRIDE;
 
 	uint32 get_cost_upslope() const OVERRIDE { return 25; }
 
+	bool get_route_cache_id(uint64 &id) const OVERRIDE;
+
 	// returns true for the way search to an unknown target.
 	bool is_target(const grund_t *,const grund_t *) const OVERRIDE;
 	bool is_coupling_target(const grund_t *, const grund_t *, sint16 &) const OVERRIDE;